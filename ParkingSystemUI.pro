@@ -16,7 +16,12 @@ SOURCES += \
     src/Vehicle.cpp \
     src/Zone.cpp \
     src/RollbackManager.cpp \
-    src/ParkingSystem.cpp
+    src/ParkingSystem.cpp \
+    src/ZoneLoadIndex.cpp \
+    src/ReservationBook.cpp \
+    src/AllocationSnapshot.cpp \
+    src/CommandPipeline.cpp \
+    src/WorkStealingPool.cpp
 
 # UI specific sources
 SOURCES += \
@@ -27,16 +32,32 @@ SOURCES += \
 HEADERS += \
     include/MainWindow.h \
     include/AllocationEngine.h \
+    include/AllocationPolicies.h \
+    include/AllocationSnapshot.h \
+    include/CommandPipeline.h \
     include/Common.h \
+    include/HashIndex.h \
+    include/IntrusiveList.h \
     include/LinkedList.h \
+    include/MpscQueue.h \
     include/Node.h \
+    include/NodeIterator.h \
+    include/NodePool.h \
     include/ParkingArea.h \
     include/ParkingRequest.h \
     include/ParkingSlot.h \
+    include/ReservationBook.h \
+    include/RingBuffer.h \
     include/RollbackManager.h \
+    include/SlotBitmap.h \
+    include/SlotMap.h \
+    include/SnapshotPublisher.h \
     include/Stack.h \
+    include/StripedHashIndex.h \
     include/Vehicle.h \
+    include/WorkStealingPool.h \
     include/Zone.h \
+    include/ZoneLoadIndex.h \
     include/ParkingSystem.h
 
 INCLUDEPATH += include/
@@ -0,0 +1,524 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include "LinkedList.h"
+#include "SlotMap.h"
+#include "Stack.h"
+#include "Common.h"
+#include "ParkingArea.h"
+#include "ParkingSlot.h"
+#include "ParkingSystem.h"
+#include "AllocationSnapshot.h"
+#include "CommandPipeline.h"
+
+using namespace std;
+
+// ============================================================================
+// CORE DATA STRUCTURE BENCHMARKS
+// Build: g++ -std=c++17 -O2 -Iinclude benchmark.cpp src/<core>.cpp -o benchmark
+// ============================================================================
+
+typedef chrono::steady_clock BenchClock;
+
+// Global allocation counter (every operator new in this binary goes through here)
+static long long g_allocations = 0;
+
+// The replacements stay out of line, so the optimizer never pairs an inlined
+// malloc()/free() with a new/delete it cannot see and warns about a mismatch
+#if defined(__GNUC__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+BENCH_NOINLINE void* operator new(size_t size) {
+    g_allocations++;
+    void* ptr = malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) throw bad_alloc();
+    return ptr;
+}
+
+BENCH_NOINLINE void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+BENCH_NOINLINE void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+BENCH_NOINLINE void operator delete[](void* ptr) noexcept {
+    operator delete(ptr);
+}
+
+BENCH_NOINLINE void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+BENCH_NOINLINE void operator delete[](void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+double elapsedMs(BenchClock::time_point start) {
+    return chrono::duration<double, milli>(BenchClock::now() - start).count();
+}
+
+void printBenchHeader(const string& title) {
+    cout << "\n" << string(75, '-') << endl;
+    cout << "  BENCHMARK: " << title << endl;
+    cout << string(75, '-') << endl;
+}
+
+void printBenchRow(const string& name, int n, double listMs, double otherMs, const string& unit = "ms") {
+    cout << "  " << left << setw(22) << name << right << setw(9) << n
+         << setw(14) << fixed << setprecision(2) << listMs << " " << unit
+         << setw(14) << otherMs << " " << unit
+         << setw(10) << setprecision(2) << (otherMs > 0 ? listMs / otherMs : 0.0) << "x" << endl;
+}
+
+// Sum via range-for: node links for DoublyLinkedList, a dense chunk sweep for SlotMap
+template <typename Container>
+long long sumByTraversal(const Container& container) {
+    long long sum = 0;
+    for (const int& value : container) {   // Each container's own iterator
+        sum += value;
+    }
+    return sum;
+}
+
+// BENCHMARK 1: DoublyLinkedList<T> vs SlotMap<T>
+void bench_list_vs_slotmap(int n) {
+    const int passes = 10;
+    volatile long long sink = 0;
+
+    // Insert
+    auto start = BenchClock::now();
+    DoublyLinkedList<int> list;
+    vector<Node<int>*> listNodes;
+    listNodes.reserve(n);
+    for (int i = 0; i < n; i++) {
+        list.insertBack(i);
+        listNodes.push_back(list.getTail());
+    }
+    double listInsert = elapsedMs(start);
+
+    start = BenchClock::now();
+    SlotMap<int> slotMap;
+    vector<SlotMapHandle> handles;
+    handles.reserve(n);
+    for (int i = 0; i < n; i++) {
+        handles.push_back(slotMap.insertBack(i));
+    }
+    double mapInsert = elapsedMs(start);
+    printBenchRow("insertBack", n, listInsert, mapInsert);
+
+    // Full traversal
+    start = BenchClock::now();
+    for (int p = 0; p < passes; p++) sink = sink + sumByTraversal(list);
+    double listScan = elapsedMs(start) / passes;
+
+    start = BenchClock::now();
+    for (int p = 0; p < passes; p++) sink = sink + sumByTraversal(slotMap);
+    double mapScan = elapsedMs(start) / passes;
+    printBenchRow("traverse", n, listScan, mapScan);
+
+    // Erase every other element by node pointer / handle
+    start = BenchClock::now();
+    for (int i = 0; i < n; i += 2) list.removeNode(listNodes[i]);
+    double listErase = elapsedMs(start);
+
+    start = BenchClock::now();
+    for (int i = 0; i < n; i += 2) slotMap.erase(handles[i]);
+    double mapErase = elapsedMs(start);
+    printBenchRow("erase (half)", n, listErase, mapErase);
+
+    // Re-fill the holes, then traverse the fragmented containers
+    for (int i = 0; i < n; i += 2) list.insertBack(i);
+    for (int i = 0; i < n; i += 2) slotMap.insertBack(i);
+
+    start = BenchClock::now();
+    for (int p = 0; p < passes; p++) sink = sink + sumByTraversal(list);
+    listScan = elapsedMs(start) / passes;
+
+    start = BenchClock::now();
+    for (int p = 0; p < passes; p++) sink = sink + sumByTraversal(slotMap);
+    mapScan = elapsedMs(start) / passes;
+    printBenchRow("traverse after churn", n, listScan, mapScan);
+}
+
+// BENCHMARK 2: Heap vs pooled node allocation under request churn
+template <typename ListType, typename StackType>
+void runNodeChurn(ListType& list, StackType& history, int ops) {
+    for (int i = 0; i < ops; i++) {
+        // Request arrives, one command recorded, request leaves, command undone
+        list.insertBack(i);
+        history.push(Command());
+        if (list.getSize() > 64) {
+            list.removeFront();
+            history.pop();
+        }
+    }
+}
+
+template <typename ListType, typename StackType>
+void bench_node_churn(const string& name, int ops) {
+    {
+        // Untimed warm-up so first-touch page faults are not counted
+        ListType warmList;
+        StackType warmHistory;
+        runNodeChurn(warmList, warmHistory, ops);
+    }
+
+    ListType list;
+    StackType history;
+
+    long long allocsBefore = g_allocations;
+    auto start = BenchClock::now();
+    runNodeChurn(list, history, ops);
+    double ms = elapsedMs(start);
+    long long allocs = g_allocations - allocsBefore;
+
+    cout << "  " << left << setw(22) << name << right << setw(9) << ops
+         << setw(14) << fixed << setprecision(2) << ms << " ms"
+         << setw(16) << setprecision(4) << (double)allocs / (2.0 * ops) << endl;
+}
+
+// BENCHMARK 3: Free-slot search in a 90% occupied area
+// Area is filled first-fit (so the occupied prefix is dense), then each op
+// frees a random occupied slot and allocates the first free one again.
+ParkingSlot* legacyFindAvailableSlot(const vector<ParkingSlot*>& slots) {
+    for (ParkingSlot* slot : slots) {
+        if (slot->getIsAvailable()) return slot;
+    }
+    return nullptr;
+}
+
+template <typename FindFn>
+double runAreaChurn(vector<ParkingSlot*>& slots, int occupied, int ops, FindFn findFree) {
+    unsigned int seed = 12345;
+    auto start = BenchClock::now();
+    for (int i = 0; i < ops; i++) {
+        seed = seed * 1103515245u + 12345u;
+        slots[(seed >> 8) % occupied]->free();
+        ParkingSlot* slot = findFree();
+        if (slot != nullptr) slot->allocate();
+    }
+    return elapsedMs(start);
+}
+
+void bench_area_scan(int n) {
+    ParkingArea area(1);
+    vector<ParkingSlot*> slots;
+    slots.reserve(n);
+    for (int i = 0; i < n; i++) {
+        slots.push_back(new ParkingSlot(i + 1, 1));
+        area.addSlot(slots.back());
+    }
+    int occupied = n / 10 * 9;
+    for (int i = 0; i < occupied; i++) slots[i]->allocate();
+
+    const int ops = 200;
+    double legacyMs = runAreaChurn(slots, occupied, ops,
+                                   [&]() { return legacyFindAvailableSlot(slots); });
+    double bitmapMs = runAreaChurn(slots, occupied, ops,
+                                   [&]() { return area.findAvailableSlot(); });
+    printBenchRow("free + allocate", n, legacyMs * 1000.0 / ops, bitmapMs * 1000.0 / ops, "us");
+
+    for (ParkingSlot* slot : slots) delete slot;
+}
+
+// BENCHMARK 4: Deep capture of allocation state vs copy-on-write snapshot copy
+void bench_snapshot(int zoneCount, int slotsPerZone) {
+    ParkingSystem system;
+    system.setVerbose(false);
+    streambuf* console = cout.rdbuf(nullptr);   // Zone creation always logs
+    for (int z = 1; z <= zoneCount; z++) system.createZone(z, slotsPerZone);
+    cout.rdbuf(console);
+    int n = zoneCount * slotsPerZone;
+
+    const int ops = 20;
+    BenchClock::time_point start = BenchClock::now();
+    for (int i = 0; i < ops; i++) {
+        AllocationSnapshot deep = system.createSnapshot();
+        if (deep.getTotalAvailableSlots() != n) cout << "  (mismatch)" << endl;
+    }
+    double captureMs = elapsedMs(start);
+
+    AllocationSnapshot base = system.createSnapshot();
+    start = BenchClock::now();
+    for (int i = 0; i < ops; i++) {
+        AllocationSnapshot scenario = base;   // Copy, then one write (copies one zone/area)
+        scenario.allocate(1 + i % zoneCount);
+    }
+    double cloneMs = elapsedMs(start);
+    printBenchRow("snapshot + 1 alloc", n, captureMs * 1000.0 / ops, cloneMs * 1000.0 / ops, "us");
+}
+
+// BENCHMARK 5: Thread-safe ParkingSystem throughput by thread count
+// Each thread serves its own gate: vehicles park and leave in zones owned by
+// that thread, so only the short registry/history sections are shared
+double runGateThreads(int threadCount, int zoneCount, int cyclesPerThread) {
+    ParkingSystem system(1024);
+    system.setVerbose(false);
+    streambuf* console = cout.rdbuf(nullptr);
+    for (int z = 1; z <= zoneCount; z++) system.createZone(z, 256);
+    cout.rdbuf(console);
+    system.setThreadSafe(true);
+
+    BenchClock::time_point start = BenchClock::now();
+    vector<thread> gates;
+    for (int t = 0; t < threadCount; t++) {
+        gates.emplace_back([&system, t, threadCount, zoneCount, cyclesPerThread]() {
+            for (int i = 0; i < cyclesPerThread; i++) {
+                string vehicleID = "G" + to_string(t) + "-" + to_string(i);
+                int zoneID = 1 + (t + threadCount * (i % 4)) % zoneCount;
+                system.createRequest(vehicleID, zoneID);
+                system.allocateSlotForRequest(vehicleID);
+                system.occupyRequest(vehicleID);
+                system.releaseRequest(vehicleID);
+            }
+        });
+    }
+    for (thread& gate : gates) gate.join();
+    return elapsedMs(start);
+}
+
+void bench_gate_threads(int maxThreads) {
+    const int cyclesPerThread = 20000;
+    double baseRate = 0.0;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        double ms = runGateThreads(threads, 64, cyclesPerThread);
+        double rate = threads * cyclesPerThread / (ms / 1000.0);   // park/leave cycles per second
+        if (threads == 1) baseRate = rate;
+        cout << "  " << left << setw(22) << "park + leave" << right << setw(9) << threads
+             << setw(14) << fixed << setprecision(2) << ms << " ms"
+             << setw(14) << setprecision(0) << rate
+             << setw(10) << setprecision(2) << rate / baseRate << "x" << endl;
+    }
+}
+
+// BENCHMARK 6: Engine slot claim + free by thread count, one zone per thread
+// Only the allocation engine is exercised: the slot CAS, the zone counters and
+// the facility-wide counters, bitmaps and load indexes every claim updates
+double runZoneClaims(int threadCount, int claimsPerThread) {
+    ParkingSystem system(64);
+    system.setVerbose(false);
+    streambuf* console = cout.rdbuf(nullptr);
+    for (int z = 1; z <= threadCount; z++) system.createZone(z, 256);
+    cout.rdbuf(console);
+    system.setThreadSafe(true);
+    AllocationEngine* engine = system.getEngine();
+
+    BenchClock::time_point start = BenchClock::now();
+    vector<thread> workers;
+    for (int t = 0; t < threadCount; t++) {
+        workers.emplace_back([engine, t, claimsPerThread]() {
+            Zone* zone = engine->findZoneByID(t + 1);
+            ParkingSlot* held[8];
+            for (int i = 0; i < claimsPerThread; i += 8) {
+                for (int k = 0; k < 8; k++) held[k] = engine->claimSlotInZone(zone, SlotSize::STANDARD);
+                for (int k = 0; k < 8; k++) engine->freeSlot(held[k]->getHandle());
+            }
+        });
+    }
+    for (thread& worker : workers) worker.join();
+    return elapsedMs(start);
+}
+
+void bench_zone_claims(int maxThreads) {
+    const int claimsPerThread = 400000;
+    double baseRate = 0.0;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        double ms = runZoneClaims(threads, claimsPerThread);
+        double rate = threads * claimsPerThread / (ms / 1000.0);   // claim + free pairs per second
+        if (threads == 1) baseRate = rate;
+        cout << "  " << left << setw(22) << "claim + free" << right << setw(9) << threads
+             << setw(14) << fixed << setprecision(2) << ms << " ms"
+             << setw(14) << setprecision(0) << rate
+             << setw(10) << setprecision(2) << rate / baseRate << "x" << endl;
+    }
+}
+
+// BENCHMARK 7: Single-writer command pipeline throughput by producer count
+// Same workload as benchmark 5, but gates only enqueue commands and one
+// engine thread applies them to a ParkingSystem in single-threaded mode
+double runPipelineProducers(int producerCount, int zoneCount, int cyclesPerProducer) {
+    ParkingSystem system(1024);
+    system.setVerbose(false);
+    streambuf* console = cout.rdbuf(nullptr);
+    for (int z = 1; z <= zoneCount; z++) system.createZone(z, 256);
+    cout.rdbuf(console);
+    CommandPipeline pipeline(&system);
+    pipeline.start();
+
+    BenchClock::time_point start = BenchClock::now();
+    vector<thread> gates;
+    for (int t = 0; t < producerCount; t++) {
+        gates.emplace_back([&pipeline, t, producerCount, zoneCount, cyclesPerProducer]() {
+            PipelineCallback ignore = [](bool) {};
+            for (int i = 0; i < cyclesPerProducer; i++) {
+                string vehicleID = "G" + to_string(t) + "-" + to_string(i);
+                int zoneID = 1 + (t + producerCount * (i % 4)) % zoneCount;
+                pipeline.submit(PipelineCommandType::CREATE, vehicleID, ignore, zoneID);
+                pipeline.submit(PipelineCommandType::ALLOCATE, vehicleID, ignore);
+                pipeline.submit(PipelineCommandType::OCCUPY, vehicleID, ignore);
+                pipeline.submit(PipelineCommandType::RELEASE, vehicleID, ignore);
+            }
+        });
+    }
+    for (thread& gate : gates) gate.join();
+    pipeline.stop();   // Returns once every submitted command is applied
+    return elapsedMs(start);
+}
+
+void bench_pipeline_producers(int maxProducers) {
+    const int cyclesPerProducer = 20000;
+    double baseRate = 0.0;
+    for (int producers = 1; producers <= maxProducers; producers *= 2) {
+        double ms = runPipelineProducers(producers, 64, cyclesPerProducer);
+        double rate = producers * cyclesPerProducer / (ms / 1000.0);
+        if (producers == 1) baseRate = rate;
+        cout << "  " << left << setw(22) << "park + leave" << right << setw(9) << producers
+             << setw(14) << fixed << setprecision(2) << ms << " ms"
+             << setw(14) << setprecision(0) << rate
+             << setw(10) << setprecision(2) << rate / baseRate << "x" << endl;
+    }
+}
+
+// BENCHMARK 8: getDashboardStats latency by core count
+// History and zone aggregation run as chunks on a work-stealing pool; "cores"
+// counts the pool workers plus the calling thread
+void bench_dashboard_cores(int historySize, int maxCores) {
+    ParkingSystem system(64);
+    system.setVerbose(false);
+    streambuf* console = cout.rdbuf(nullptr);
+    for (int z = 1; z <= 999; z++) system.createZone(z, 16);
+    for (int i = 0; i < historySize; i++) {
+        string vehicleID = "H" + to_string(i);
+        system.createRequest(vehicleID, 1 + i % 999);
+        if (i % 3 == 0) system.allocateSlotForRequest(vehicleID);
+        system.cancelRequest(vehicleID);
+    }
+    cout.rdbuf(console);
+
+    const int passes = 20;
+    volatile int sink = 0;
+    double baseMs = 0.0;
+    for (int cores = 1; cores <= maxCores; cores *= 2) {
+        system.setAnalyticsThreads(cores - 1);
+        sink += system.getDashboardStats().requestsCancelled;   // Warm-up (wakes the workers)
+        BenchClock::time_point start = BenchClock::now();
+        for (int p = 0; p < passes; p++) {
+            sink += system.getDashboardStats().requestsCancelled;
+        }
+        double ms = elapsedMs(start) / passes;
+        if (cores == 1) baseMs = ms;
+        cout << "  " << left << setw(22) << "getDashboardStats" << right << setw(9) << cores
+             << setw(14) << fixed << setprecision(3) << ms << " ms"
+             << setw(14) << historySize
+             << setw(10) << setprecision(2) << baseMs / ms << "x" << endl;
+    }
+    system.setAnalyticsThreads(0);
+}
+
+// BENCHMARK 9: Dashboard read cost, live aggregation vs published snapshot
+// Readers of getPublishedDashboard() only pin an epoch and take a reference,
+// however large the history and zone set behind it
+void bench_dashboard_reads(int historySize) {
+    ParkingSystem system(64);
+    system.setVerbose(false);
+    streambuf* console = cout.rdbuf(nullptr);
+    for (int z = 1; z <= 999; z++) system.createZone(z, 16);
+    for (int i = 0; i < historySize; i++) {
+        string vehicleID = "H" + to_string(i);
+        system.createRequest(vehicleID, 1 + i % 999);
+        system.cancelRequest(vehicleID);
+    }
+    cout.rdbuf(console);
+    system.publishDashboard();
+
+    const int livePasses = 10;
+    const int snapshotPasses = 1000000;
+    volatile int sink = 0;
+    BenchClock::time_point start = BenchClock::now();
+    for (int p = 0; p < livePasses; p++) {
+        sink += system.getDashboardStats().totalRequests;
+    }
+    double liveUs = elapsedMs(start) * 1000.0 / livePasses;
+
+    start = BenchClock::now();
+    for (int p = 0; p < snapshotPasses; p++) {
+        sink += system.getPublishedDashboard()->totalRequests;
+    }
+    double snapshotUs = elapsedMs(start) * 1000.0 / snapshotPasses;
+    printBenchRow("dashboard read", historySize, liveUs, snapshotUs, "us");
+}
+
+int main() {
+    cout << "\n" << string(75, '=') << endl;
+    cout << "  PARKING SYSTEM - DATA STRUCTURE BENCHMARKS" << endl;
+    cout << string(75, '=') << endl;
+
+    printBenchHeader("DoublyLinkedList<int> vs SlotMap<int>");
+    cout << "  " << left << setw(22) << "operation" << right << setw(9) << "n"
+         << setw(17) << "list" << setw(17) << "slot map" << setw(11) << "speedup" << endl;
+    bench_list_vs_slotmap(10000);
+    bench_list_vs_slotmap(100000);
+    bench_list_vs_slotmap(1000000);
+
+    printBenchHeader("Node allocation per list/stack operation");
+    cout << "  " << left << setw(22) << "allocator" << right << setw(9) << "ops"
+         << setw(17) << "time" << setw(16) << "allocs/op" << endl;
+    for (int ops : {100000, 1000000}) {
+        bench_node_churn<DoublyLinkedList<int>, Stack<Command>>("heap (new/delete)", ops);
+        bench_node_churn<DoublyLinkedList<int, PooledNodeAllocator<int>>,
+                         Stack<Command, PooledNodeAllocator<Command>>>("pooled", ops);
+    }
+
+    printBenchHeader("ParkingArea free-slot search at 90% occupancy (per op)");
+    cout << "  " << left << setw(22) << "operation" << right << setw(9) << "slots"
+         << setw(17) << "linear scan" << setw(17) << "bitmap" << setw(11) << "speedup" << endl;
+    bench_area_scan(10000);
+    bench_area_scan(100000);
+    bench_area_scan(1000000);
+
+    printBenchHeader("What-if snapshot: deep capture vs copy-on-write copy (per op)");
+    cout << "  " << left << setw(22) << "operation" << right << setw(9) << "slots"
+         << setw(17) << "deep capture" << setw(17) << "cow copy" << setw(11) << "speedup" << endl;
+    bench_snapshot(16, 10000);
+    bench_snapshot(64, 20000);
+
+    int cores = (int)thread::hardware_concurrency();
+    printBenchHeader("Thread-safe mode: gate throughput by thread count (" + to_string(cores) + " cores)");
+    cout << "  " << left << setw(22) << "operation" << right << setw(9) << "threads"
+         << setw(17) << "time" << setw(14) << "cycles/s" << setw(11) << "scaling" << endl;
+    bench_gate_threads(cores > 1 ? cores : 4);
+
+    printBenchHeader("Allocation engine: claim throughput, one zone per thread (" + to_string(cores) + " cores)");
+    cout << "  " << left << setw(22) << "operation" << right << setw(9) << "threads"
+         << setw(17) << "time" << setw(14) << "claims/s" << setw(11) << "scaling" << endl;
+    bench_zone_claims(cores > 1 ? cores : 4);
+
+    printBenchHeader("Command pipeline: gate throughput by producer count (" + to_string(cores) + " cores)");
+    cout << "  " << left << setw(22) << "operation" << right << setw(9) << "producers"
+         << setw(17) << "time" << setw(14) << "cycles/s" << setw(11) << "scaling" << endl;
+    bench_pipeline_producers(cores > 1 ? cores : 4);
+
+    printBenchHeader("Dashboard aggregation latency by core count (" + to_string(cores) + " cores)");
+    cout << "  " << left << setw(22) << "operation" << right << setw(9) << "cores"
+         << setw(17) << "latency" << setw(14) << "history" << setw(11) << "speedup" << endl;
+    bench_dashboard_cores(500000, cores > 1 ? cores : 4);
+
+    printBenchHeader("Dashboard read: live getDashboardStats vs published snapshot (per op)");
+    cout << "  " << left << setw(22) << "operation" << right << setw(9) << "history"
+         << setw(17) << "live" << setw(17) << "snapshot" << setw(11) << "speedup" << endl;
+    bench_dashboard_reads(100000);
+    bench_dashboard_reads(500000);
+
+    cout << "\n" << string(75, '=') << endl;
+    return 0;
+}
@@ -5,14 +5,58 @@
 #include "ParkingSlot.h"
 #include "ParkingRequest.h"
 #include "Zone.h"
-#include "LinkedList.h"
+#include "SlotMap.h"
+#include "HashIndex.h"
+#include "ZoneLoadIndex.h"
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+// ============================================================================
+// SLOT PLACEMENT (Returned by allocation policies)
+// ============================================================================
+struct SlotPlacement {
+    ParkingSlot* slot;   // Free slot chosen by the policy, nullptr if none
+    Zone* zone;          // Zone the slot belongs to
+    double penalty;      // Charged to the request when the placement is committed
+
+    SlotPlacement(ParkingSlot* s, Zone* z, double p) : slot(s), zone(z), penalty(p) {}
+};
 
 // ============================================================================
 // ALLOCATION ENGINE CLASS
 // ============================================================================
 class AllocationEngine {
+public:
+    // Zone IDs below this are looked up in a flat array, others in a hash index
+    static const int DENSE_ZONE_ID_LIMIT = 4096;
+
 private:
-    DoublyLinkedList<Zone*> allZones;
+    SlotMap<Zone*> allZones;
+    std::vector<Zone*> denseZoneTable;          // zoneID -> Zone* for 0 <= zoneID < DENSE_ZONE_ID_LIMIT
+    HashIndex<int, Zone*> sparseZoneTable;      // zoneID -> Zone* for all other IDs
+    std::atomic<int> facilityCapacity;          // Facility-wide totals, updated by the zones
+    std::atomic<int> facilityAvailableSlots;    // (atomic so fast-fail checks need no lock)
+    std::atomic<int> facilityAvailableBySize[SLOT_SIZE_COUNT];
+    ZoneLoadIndex loadIndex;                    // Free-slot count per zone position
+    ZoneLoadIndex loadIndexBySize[SLOT_SIZE_COUNT];   // Same positions, one index per size class
+    std::vector<Zone*> zonesByPosition;         // Load index position -> zone
+    mutable AtomicSlotBitmap nonFullZones;      // Bit per zone position, set while the zone has a free slot
+    mutable AtomicSlotBitmap nonFullZonesBySize[SLOT_SIZE_COUNT];   // Same, per slot size class
+    std::atomic<bool> overflowOrdersDirty;      // Zone added or adjacency changed since last rebuild
+    bool verbose;                               // Log cross-zone penalties to the console
+    AllocationPolicyType policyType;            // Instantiation used by allocateSlot()
+    AtomicSlotBitmap staleLoadPositions;        // Zones whose load index leaves trail their counters
+    AtomicSlotBitmap staleLoadPositionsBySize[SLOT_SIZE_COUNT];
+    bool threadSafe;                            // Take the zone/facility locks below
+    std::mutex loadIndexMutex;                  // Held by whichever thread is refreshing the load indexes
+    mutable std::mutex facilityMutex;           // Overflow order rebuild only
+    
+    std::unique_lock<std::mutex> lockFacility() const;   // Empty lock unless thread-safe
+    
+    void refreshLoadIndexes();                  // Bring stale load index leaves up to date; never blocks
+    void rebuildOverflowOrders();               // BFS from every zone - O(Z * (Z + E))
+    void commitPlacement(const SlotPlacement& placement, ParkingRequest* parkingRequest);
 
 public:
     // Constructor
@@ -24,47 +68,136 @@ public:
     // ========================================================================
     // ZONE MANAGEMENT
     // ========================================================================
-    void addZone(Zone* zone);
-    Zone* findZoneByID(int zoneID);
+    bool addZone(Zone* zone);              // false if null or the zone ID is taken
+    Zone* findZoneByID(int zoneID) const;  // O(1)
+    bool hasZone(int zoneID) const;
+    bool connectZones(int zoneA, int zoneB);   // Mark two zones as adjacent (both directions)
+    void invalidateOverflowOrders();           // Called by Zone when its adjacency changes
     
     // ========================================================================
     // ALLOCATION ALGORITHM
     // ========================================================================
     
     /**
-     * Allocate a parking slot for a vehicle
+     * Allocate a parking slot for a vehicle using the selected policy
      * 
-     * Algorithm:
+     * Default algorithm (NearestAdjacentPolicy):
      * 1. Search in requestedZone first
      * 2. If found, return the slot
-     * 3. If not found, check adjacentZones
-     * 4. If found in adjacentZone, mark penalty and return
+     * 3. If not found, search connected zones nearest-first by adjacency hops
+     *    and charge CROSS_ZONE_PENALTY_PER_HOP per hop
+     * 4. Otherwise take the least-loaded zone and charge UNCONNECTED_ZONE_PENALTY
      * 5. If no slot available anywhere, return nullptr
      * 
+     * Best fit: the policy runs for the vehicle's own size class first and
+     * moves up to a larger class only when no slot of that class is free anywhere.
+     * 
      * @param vehicle - The vehicle requesting parking
      * @param parkingRequest - The parking request object to update with penalties
      * @return ParkingSlot* - Pointer to allocated slot, or nullptr if no slot available
      */
     ParkingSlot* allocateSlot(Vehicle* vehicle, ParkingRequest* parkingRequest);
     
+    /**
+     * Same as allocateSlot() with the requested zone already resolved
+     * (nullptr if it does not exist) - lets batch callers look a zone up once
+     */
+    ParkingSlot* allocateSlotInZone(Zone* requestedZone, ParkingRequest* parkingRequest);
+    
+    /**
+     * Allocate with a compile-time policy (see AllocationPolicies.h)
+     * Policy::place() is inlined into each instantiation; allocateSlot()
+     * switches between the prebuilt ones according to setAllocationPolicy()
+     */
+    template <typename Policy>
+    ParkingSlot* allocateWith(Zone* requestedZone, ParkingRequest* parkingRequest);
+    
+    void setAllocationPolicy(AllocationPolicyType type);
+    AllocationPolicyType getAllocationPolicy() const;
+    
     /**
      * Free a parking slot (vehicle departs)
      * 
-     * @param slotID - The slot ID to free
+     * @param handle - Handle of the slot to free (see ParkingRequest::getAllocatedSlotHandle)
      * @return bool - Success or failure
      */
-    bool freeSlot(int slotID);
+    bool freeSlot(SlotHandle handle);
+    
+    /**
+     * Resolve a slot handle through the zone table and area directories
+     * 
+     * @return ParkingSlot* - The slot, or nullptr if the handle is invalid - O(1)
+     */
+    ParkingSlot* resolveSlot(SlotHandle handle) const;
     
     // ========================================================================
-    // SEARCH HELPERS
+    // SEARCH HELPERS (Building blocks for allocation policies)
     // ========================================================================
-    ParkingSlot* searchInZone(Zone* zone);
-    ParkingSlot* searchInAdjacentZones(Zone* primaryZone, ParkingRequest* parkingRequest);
+    ParkingSlot* claimSlotInZone(Zone* zone, SlotSize size);   // Claims a free slot of this size by CAS, nullptr if none
+    const std::vector<OverflowCandidate>& getOverflowOrder(Zone* zone);   // Rebuilt first if stale
+    bool hasFreeSlotAt(int position, SlotSize size) const;  // Zone at this load index position - O(1)
+    int getZoneAvailableSlots(Zone* zone, SlotSize size) const;
+    Zone* getZoneAtPosition(int position) const;
+    int getZonePositionCount() const;
     
     // ========================================================================
     // GETTERS
     // ========================================================================
-    DoublyLinkedList<Zone*>& getAllZones();
+    SlotMap<Zone*>& getAllZones();
+    int getTotalCapacity() const;          // O(1)
+    int getTotalAvailableSlots() const;    // O(1)
+    int getTotalAvailableSlots(SlotSize size) const;
+    Zone* getMostAvailableZone() const;    // Zone with the most free slots, nullptr if none - O(1)
+    Zone* findAnyNonFullZone() const;      // Lowest-position zone with a free slot - O(log Z)
+    Zone* getMostAvailableZone(SlotSize size) const;   // Same, per size class
+    Zone* findAnyNonFullZone(SlotSize size) const;
+    bool isFacilityFull() const;           // O(1) admission check
+    void setVerbose(bool enabled);
+    bool isVerbose() const;
+    
+    // ========================================================================
+    // THREAD SAFETY
+    // ========================================================================
+    // Slots are claimed and released by CAS (ParkingSlot::allocate/free), so
+    // allocation and release take no zone lock; racing claimers simply move on
+    // to the next free slot. Facility counters are atomics and the non-full
+    // bitmaps are updated bit by bit, so a claim or release in one zone never
+    // waits for one in another. The load index trees are refreshed by
+    // whichever writer wins a try-lock, the others only flag their zone as
+    // stale. The per-zone lock (Zone::getSlotMutex) guards only the zone's
+    // reservation book; the facility lock is for structural changes. Lock
+    // order is zone, then facility.
+    // Structural changes (addZone, connectZones) must still not overlap
+    // allocation; ParkingSystem serializes them.
+    void setThreadSafe(bool enabled);
+    bool isThreadSafe() const;
+    std::unique_lock<std::mutex> lockZone(Zone* zone) const;   // Empty lock unless thread-safe
+    
+    // Called by Zone (after updating its own counters) whenever its capacity or free count changes
+    void adjustFacilityCounts(Zone* zone, SlotSize size, int capacityDelta, int availableDelta);
 };
 
+template <typename Policy>
+ParkingSlot* AllocationEngine::allocateWith(Zone* requestedZone, ParkingRequest* parkingRequest) {
+    if (parkingRequest == nullptr) {
+        return nullptr;
+    }
+
+    // Fast fail: nothing is free anywhere, so skip every search
+    if (isFacilityFull()) {
+        return nullptr;
+    }
+
+    // Best fit: own size class first, larger classes only once it is exhausted
+    for (int s = slotSizeIndex(requiredSlotSize(parkingRequest->getVehicleType())); s < SLOT_SIZE_COUNT; s++) {
+        if (facilityAvailableBySize[s] == 0) continue;   // O(1) per class
+        SlotPlacement placement = Policy::place(*this, requestedZone, static_cast<SlotSize>(s));
+        if (placement.slot != nullptr) {
+            commitPlacement(placement, parkingRequest);
+            return placement.slot;
+        }
+    }
+    return nullptr;
+}
+
 #endif // ALLOCATIONENGINE_H
@@ -0,0 +1,128 @@
+#ifndef ALLOCATIONPOLICIES_H
+#define ALLOCATIONPOLICIES_H
+
+#include "AllocationEngine.h"
+#include "Common.h"
+
+// ============================================================================
+// ALLOCATION POLICIES (Used through AllocationEngine::allocateWith<Policy>)
+// ============================================================================
+// A policy is a type with
+//     template <typename Engine>
+//     static SlotPlacement place(Engine& engine, Zone* requestedZone, SlotSize size);
+// returning a slot of exactly that size class (slot == nullptr if none) and
+// the penalty to charge. Slots come from engine.claimSlotInZone(), which
+// takes the slot atomically, so a policy must return every slot it claims.
+// A claim can lose a race with another thread even after the index showed
+// a free slot, so fallbacks re-query the index and retry until it reports
+// no zone left, rather than giving up after one attempt.
+// The engine handles best fit across size classes and commits the
+// placement, so each policy only decides where to look. Policies are plain structs with
+// static members, so every probe is inlined into its allocateWith<>
+// instantiation - no virtual dispatch on the allocation path. Engine is
+// AllocationEngine for live allocation or AllocationSnapshot for what-if
+// runs; both expose the same search primitives.
+
+// Requested zone, else the lowest-position zone with a free slot - O(log Z)
+struct FirstFitPolicy {
+    template <typename Engine>
+    static SlotPlacement place(Engine& engine, Zone* requestedZone, SlotSize size) {
+        ParkingSlot* slot = engine.claimSlotInZone(requestedZone, size);
+        if (slot != nullptr) {
+            return SlotPlacement(slot, requestedZone, 0.0);
+        }
+        for (Zone* zone = engine.findAnyNonFullZone(size); zone != nullptr; zone = engine.findAnyNonFullZone(size)) {
+            slot = engine.claimSlotInZone(zone, size);
+            if (slot != nullptr) {
+                return SlotPlacement(slot, zone, PenaltyCosts::UNCONNECTED_ZONE_PENALTY);
+            }
+        }
+        return SlotPlacement(nullptr, nullptr, PenaltyCosts::UNCONNECTED_ZONE_PENALTY);
+    }
+};
+
+// Requested zone, then connected zones nearest-first (penalty per hop), then
+// the least-loaded zone with the flat unconnected penalty
+struct NearestAdjacentPolicy {
+    template <typename Engine>
+    static SlotPlacement place(Engine& engine, Zone* requestedZone, SlotSize size) {
+        if (requestedZone != nullptr) {
+            ParkingSlot* slot = engine.claimSlotInZone(requestedZone, size);
+            if (slot != nullptr) {
+                return SlotPlacement(slot, requestedZone, 0.0);
+            }
+
+            for (const OverflowCandidate& candidate : engine.getOverflowOrder(requestedZone)) {
+                if (!engine.hasFreeSlotAt(candidate.position, size)) continue;   // Full: skip without touching the zone
+                slot = engine.claimSlotInZone(candidate.zone, size);
+                if (slot != nullptr) {
+                    return SlotPlacement(slot, candidate.zone,
+                                         PenaltyCosts::CROSS_ZONE_PENALTY_PER_HOP * candidate.hops);
+                }
+            }
+        }
+
+        for (Zone* zone = engine.getMostAvailableZone(size); zone != nullptr; zone = engine.getMostAvailableZone(size)) {
+            ParkingSlot* slot = engine.claimSlotInZone(zone, size);
+            if (slot != nullptr) {
+                return SlotPlacement(slot, zone, PenaltyCosts::UNCONNECTED_ZONE_PENALTY);
+            }
+        }
+        return SlotPlacement(nullptr, nullptr, PenaltyCosts::UNCONNECTED_ZONE_PENALTY);
+    }
+};
+
+// Zone with the most free slots of the size class, spreading load evenly;
+// free only when that happens to be the requested zone - O(1) pick
+struct LeastLoadedPolicy {
+    template <typename Engine>
+    static SlotPlacement place(Engine& engine, Zone* requestedZone, SlotSize size) {
+        for (Zone* zone = engine.getMostAvailableZone(size); zone != nullptr; zone = engine.getMostAvailableZone(size)) {
+            ParkingSlot* slot = engine.claimSlotInZone(zone, size);
+            if (slot != nullptr) {
+                double penalty = (zone == requestedZone) ? 0.0 : PenaltyCosts::UNCONNECTED_ZONE_PENALTY;
+                return SlotPlacement(slot, zone, penalty);
+            }
+        }
+        return SlotPlacement(nullptr, nullptr, PenaltyCosts::UNCONNECTED_ZONE_PENALTY);
+    }
+};
+
+// Requested zone, else the fullest zone that still has a free slot, keeping
+// emptier zones whole for later arrivals - O(Z) scan on overflow
+struct PackDenselyPolicy {
+    template <typename Engine>
+    static SlotPlacement place(Engine& engine, Zone* requestedZone, SlotSize size) {
+        ParkingSlot* slot = engine.claimSlotInZone(requestedZone, size);
+        if (slot != nullptr) {
+            return SlotPlacement(slot, requestedZone, 0.0);
+        }
+
+        for (Zone* zone = findFullestZone(engine, size); zone != nullptr; zone = findFullestZone(engine, size)) {
+            slot = engine.claimSlotInZone(zone, size);
+            if (slot != nullptr) {
+                return SlotPlacement(slot, zone, PenaltyCosts::UNCONNECTED_ZONE_PENALTY);
+            }
+        }
+        return SlotPlacement(nullptr, nullptr, PenaltyCosts::UNCONNECTED_ZONE_PENALTY);
+    }
+
+    // Zone with the fewest free slots of the size class that still has one
+    template <typename Engine>
+    static Zone* findFullestZone(Engine& engine, SlotSize size) {
+        Zone* fullest = nullptr;
+        int fewestFree = 0;
+        for (int position = 0; position < engine.getZonePositionCount(); position++) {
+            if (!engine.hasFreeSlotAt(position, size)) continue;
+            Zone* zone = engine.getZoneAtPosition(position);
+            int free = engine.getZoneAvailableSlots(zone, size);
+            if (fullest == nullptr || free < fewestFree) {
+                fullest = zone;
+                fewestFree = free;
+            }
+        }
+        return fullest;
+    }
+};
+
+#endif // ALLOCATIONPOLICIES_H
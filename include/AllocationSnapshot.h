@@ -0,0 +1,107 @@
+#ifndef ALLOCATIONSNAPSHOT_H
+#define ALLOCATIONSNAPSHOT_H
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "AllocationEngine.h"
+#include "Common.h"
+#include "SlotBitmap.h"
+
+// ============================================================================
+// SIMULATED ALLOCATION STRUCT (Result of a what-if allocation)
+// ============================================================================
+struct SimulatedAllocation {
+    bool allocated;
+    int zoneID;
+    int slotID;
+    double penaltyCost;
+    SlotHandle handle;   // Live slot that would be taken; pass to release()
+
+    SimulatedAllocation() : allocated(false), zoneID(-1), slotID(-1), penaltyCost(0.0) {}
+};
+
+// ============================================================================
+// ALLOCATION SNAPSHOT CLASS (Copy-on-write what-if state)
+// ============================================================================
+// Private copy of the facility's slot availability that the allocation
+// policies can run against without touching live state. Zones and areas are
+// held through shared_ptr and copied only when a simulation first writes to
+// them, so copying a snapshot costs O(Z) pointer copies however many slots
+// the facility has. Only availability is copied: zones, areas and slots are
+// referenced by their live objects, whose identity and topology are read but
+// never written. A snapshot and its copies must stay on one thread.
+class AllocationSnapshot {
+private:
+    struct AreaState {
+        SlotBitmap availableBySize[SLOT_SIZE_COUNT];   // Copied from the live area
+    };
+
+    struct ZoneState {
+        Zone* zone;
+        std::vector<std::shared_ptr<AreaState>> areas;   // By area index
+        int availableBySize[SLOT_SIZE_COUNT];
+        bool closed;
+    };
+
+    typedef std::vector<std::vector<OverflowCandidate>> OverflowTable;
+
+    std::vector<std::shared_ptr<ZoneState>> zones;      // By load index position
+    std::shared_ptr<const OverflowTable> overflowOrders; // By position, never written after capture
+    std::shared_ptr<const std::unordered_map<int, int>> positionsByZoneID;   // Same
+    int availableBySize[SLOT_SIZE_COUNT];
+    AllocationPolicyType policyType;
+
+    ZoneState& mutableZone(int position);                       // Copy on first write
+    AreaState& mutableArea(ZoneState& zoneState, int areaIndex);
+    const ZoneState* zoneStateFor(Zone* zone) const;   // nullptr if added after capture
+    int positionOf(int zoneID) const;                  // -1 if unknown
+
+    template <typename Policy>
+    SimulatedAllocation allocateWith(Zone* requestedZone, SlotSize required);
+
+public:
+    // Constructor (empty facility); use capture() to copy live state
+    AllocationSnapshot();
+
+    /**
+     * Copy the engine's current availability - O(Z + S/64)
+     * Later copies of the returned snapshot are O(Z)
+     */
+    static AllocationSnapshot capture(AllocationEngine& engine);
+
+    // ========================================================================
+    // SCENARIO CHANGES
+    // ========================================================================
+
+    /**
+     * Run the selected policy as AllocationEngine::allocateSlot() would and
+     * mark the chosen slot taken in this snapshot only
+     */
+    SimulatedAllocation allocate(int requestedZoneID, VehicleType type = VehicleType::SEDAN);
+    bool release(SlotHandle handle);   // Free a slot in this snapshot
+    bool closeZone(int zoneID);        // Zone takes no further allocations (e.g. maintenance)
+    void setAllocationPolicy(AllocationPolicyType type);
+
+    // ========================================================================
+    // SEARCH PRIMITIVES (Same interface as AllocationEngine, for policies)
+    // ========================================================================
+    ParkingSlot* claimSlotInZone(Zone* zone, SlotSize size);   // Marks the slot taken in this snapshot
+    const std::vector<OverflowCandidate>& getOverflowOrder(Zone* zone);
+    bool hasFreeSlotAt(int position, SlotSize size) const;
+    int getZoneAvailableSlots(Zone* zone, SlotSize size) const;
+    Zone* getZoneAtPosition(int position) const;
+    int getZonePositionCount() const;
+    Zone* getMostAvailableZone(SlotSize size) const;   // O(Z)
+    Zone* findAnyNonFullZone(SlotSize size) const;     // O(Z)
+
+    // ========================================================================
+    // GETTERS
+    // ========================================================================
+    int getTotalAvailableSlots() const;
+    int getTotalAvailableSlots(SlotSize size) const;
+    int getAvailableSlots(int zoneID) const;   // 0 for unknown or closed zones
+    bool isFacilityFull() const;
+};
+
+#endif // ALLOCATIONSNAPSHOT_H
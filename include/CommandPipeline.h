@@ -0,0 +1,122 @@
+#ifndef COMMANDPIPELINE_H
+#define COMMANDPIPELINE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "Common.h"
+#include "MpscQueue.h"
+
+class ParkingSystem;
+
+// ============================================================================
+// PIPELINE COMMAND TYPES
+// ============================================================================
+enum class PipelineCommandType {
+    CREATE,     // createRequest(vehicleID, zoneID, vehicleType)
+    ALLOCATE,   // allocateSlotForRequest(vehicleID)
+    OCCUPY,     // occupyRequest(vehicleID)
+    RELEASE,    // releaseRequest(vehicleID)
+    CANCEL      // cancelRequest(vehicleID)
+};
+
+// Called on the engine thread with the command's result
+typedef std::function<void(bool)> PipelineCallback;
+
+// ============================================================================
+// COMMAND PIPELINE CLASS (Single-writer actor in front of ParkingSystem)
+// ============================================================================
+// Gate threads submit request commands into a lock-free MPSC queue and one
+// engine thread applies them to the ParkingSystem in arrival order, so the
+// system keeps its single-threaded code paths (no setThreadSafe needed) while
+// accepting input from any number of producers. The engine thread drains up
+// to maxBatch commands per batch, completes their futures/callbacks once the
+// whole batch is applied, and sleeps only when the queue is empty.
+// While the pipeline runs, the ParkingSystem belongs to the engine thread:
+// other threads must go through submit() and not call it directly, except
+// for getPublishedDashboard(), which is safe from anywhere.
+class CommandPipeline {
+public:
+    static const int DEFAULT_MAX_BATCH = 256;
+
+private:
+    struct PipelineCommand {
+        PipelineCommandType type;
+        std::string vehicleID;
+        int zoneID;
+        VehicleType vehicleType;
+        std::unique_ptr<std::promise<bool>> completion;   // Exactly one of completion/callback is set
+        PipelineCallback callback;
+
+        PipelineCommand() : type(PipelineCommandType::CREATE), zoneID(-1), vehicleType(VehicleType::SEDAN) {}
+    };
+
+    ParkingSystem* parkingSystem;   // Not owned
+    MpscQueue<PipelineCommand> queue;
+    int maxBatch;
+    std::atomic<bool> publishAfterBatch;   // ParkingSystem::publishIfChanged() after each batch
+    std::thread engineThread;
+    std::atomic<bool> running;
+    std::atomic<bool> idle;          // Engine thread is (about to be) asleep
+    std::mutex wakeMutex;            // Only for sleeping/waking the engine thread
+    std::condition_variable wakeCondition;
+    std::atomic<long long> commandsApplied;
+    std::atomic<long long> batchesApplied;
+
+    void enqueue(PipelineCommand command);
+    void engineLoop();
+    int drainBatch();                // Applies up to maxBatch commands; returns how many
+    bool apply(const PipelineCommand& command);
+
+public:
+    // Constructor (does not start the engine thread)
+    explicit CommandPipeline(ParkingSystem* system, int batchSize = DEFAULT_MAX_BATCH);
+
+    // Destructor (stops after draining everything already submitted)
+    ~CommandPipeline();
+
+    CommandPipeline(const CommandPipeline&) = delete;
+    CommandPipeline& operator=(const CommandPipeline&) = delete;
+
+    // ========================================================================
+    // LIFECYCLE
+    // ========================================================================
+    void start();
+    void stop();   // Applies every command submitted before the call, then joins
+    bool isRunning() const;
+
+    // Publish a fresh dashboard snapshot after every drained batch, so
+    // readers of getPublishedDashboard() trail the writer by at most one batch
+    void setPublishAfterBatch(bool enabled);
+
+    // ========================================================================
+    // SUBMISSION (Any thread; lock-free unless it has to wake the engine)
+    // ========================================================================
+
+    /**
+     * Queue a command for the engine thread
+     * Commands from one thread are applied in the order they were submitted
+     *
+     * @param zoneID, vehicleType - Used by CREATE only
+     * @return std::future<bool> - Result of the ParkingSystem call
+     */
+    std::future<bool> submit(PipelineCommandType type, const std::string& vehicleID,
+                             int zoneID = -1, VehicleType vehicleType = VehicleType::SEDAN);
+
+    // Same, but the result goes to callback on the engine thread (keep it short)
+    void submit(PipelineCommandType type, const std::string& vehicleID, PipelineCallback callback,
+                int zoneID = -1, VehicleType vehicleType = VehicleType::SEDAN);
+
+    // ========================================================================
+    // GETTERS
+    // ========================================================================
+    long long getCommandsApplied() const;
+    long long getBatchesApplied() const;
+};
+
+#endif // COMMANDPIPELINE_H
@@ -1,6 +1,7 @@
 #ifndef COMMON_H
 #define COMMON_H
 
+#include <cstdint>
 #include <ctime>
 #include <string>
 
@@ -20,6 +21,37 @@ enum class RequestState {
     CANCELLED    // Request was cancelled
 };
 
+// ============================================================================
+// SLOT HANDLE (Globally unique slot address)
+// ============================================================================
+// Packs zone ID (32 bits), area index within the zone (12 bits) and slot
+// index within the area (20 bits) into one 64-bit value, so a slot can be
+// resolved in O(1) and slot numbers never collide across zones.
+struct SlotHandle {
+    static const int AREA_BITS = 12;
+    static const int SLOT_BITS = 20;
+    static const int MAX_AREAS_PER_ZONE = 1 << AREA_BITS;
+    static const int MAX_SLOTS_PER_AREA = 1 << SLOT_BITS;
+
+    uint64_t value;
+
+    SlotHandle() : value(~0ULL) {}
+
+    SlotHandle(int zoneID, int areaIndex, int slotIndex)
+        : value(((uint64_t)(uint32_t)zoneID << (AREA_BITS + SLOT_BITS)) |
+                ((uint64_t)(areaIndex & (MAX_AREAS_PER_ZONE - 1)) << SLOT_BITS) |
+                (uint64_t)(slotIndex & (MAX_SLOTS_PER_AREA - 1))) {}
+
+    bool isValid() const { return value != ~0ULL; }
+
+    int getZoneID() const { return (int)(uint32_t)(value >> (AREA_BITS + SLOT_BITS)); }
+    int getAreaIndex() const { return (int)((value >> SLOT_BITS) & (MAX_AREAS_PER_ZONE - 1)); }
+    int getSlotIndex() const { return (int)(value & (MAX_SLOTS_PER_AREA - 1)); }
+
+    bool operator==(const SlotHandle& other) const { return value == other.value; }
+    bool operator!=(const SlotHandle& other) const { return value != other.value; }
+};
+
 // ============================================================================
 // COMMAND STRUCT FOR ROLLBACK
 // ============================================================================
@@ -29,13 +61,14 @@ struct Command {
     Zone* zonePtr;
     RequestState oldState;
     RequestState newState;
+    int groupID;   // 0 = standalone; adjacent commands with the same non-zero ID roll back as one unit
     
     Command() : requestPtr(nullptr), slotPtr(nullptr), zonePtr(nullptr),
-                oldState(RequestState::REQUESTED), newState(RequestState::REQUESTED) {}
+                oldState(RequestState::REQUESTED), newState(RequestState::REQUESTED), groupID(0) {}
     
     Command(ParkingRequest* req, ParkingSlot* slot, Zone* zone,
-            RequestState old, RequestState newS) 
-        : requestPtr(req), slotPtr(slot), zonePtr(zone), oldState(old), newState(newS) {}
+            RequestState old, RequestState newS, int group = 0) 
+        : requestPtr(req), slotPtr(slot), zonePtr(zone), oldState(old), newState(newS), groupID(group) {}
 };
 
 // ============================================================================
@@ -61,6 +94,8 @@ namespace PenaltyCosts {
     const double LATE_RELEASE_PENALTY_PER_HOUR = 25.0;  // Penalty for not releasing slot on time
     const double CANCELLATION_PENALTY = 100.0;          // Penalty for cancelling a confirmed allocation
     const double INVALID_ALLOCATION_PENALTY = 75.0;     // Penalty for invalid allocation attempt
+    const double CROSS_ZONE_PENALTY_PER_HOP = 10.0;     // Overflow into a zone N adjacency hops away
+    const double UNCONNECTED_ZONE_PENALTY = 10.0;       // Overflow into a zone not reachable by adjacency
     
     // Grace periods (in hours)
     const int OVERSTAY_GRACE_PERIOD_HOURS = 1;
@@ -88,4 +123,35 @@ enum class SlotSize {
     LARGE
 };
 
+const int SLOT_SIZE_COUNT = 3;   // Size classes, ordered smallest to largest
+
+inline int slotSizeIndex(SlotSize size) {
+    return static_cast<int>(size);
+}
+
+// Smallest slot class a vehicle fits in; larger classes are used only as fallback
+inline SlotSize requiredSlotSize(VehicleType type) {
+    switch (type) {
+        case VehicleType::MOTORCYCLE:
+        case VehicleType::COMPACT:
+            return SlotSize::COMPACT;
+        case VehicleType::VAN:
+        case VehicleType::TRUCK:
+            return SlotSize::LARGE;
+        default:
+            return SlotSize::STANDARD;
+    }
+}
+
+// ============================================================================
+// ALLOCATION POLICY SELECTOR
+// ============================================================================
+// Runtime choice between the compile-time policies in AllocationPolicies.h
+enum class AllocationPolicyType {
+    FIRST_FIT,          // Requested zone, else the lowest-position zone with a free slot
+    NEAREST_ADJACENT,   // Requested zone, then zones by adjacency hops, then least loaded (default)
+    LEAST_LOADED,       // Zone with the most free slots of the size class
+    PACK_DENSELY        // Requested zone, else the fullest zone that still has a free slot
+};
+
 #endif // COMMON_H
@@ -0,0 +1,83 @@
+#ifndef FREESLOTSTACK_H
+#define FREESLOTSTACK_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+// ============================================================================
+// FREE SLOT STACK (Lock-free LIFO of dense slot indices)
+// ============================================================================
+// Treiber stack whose links live in a parallel array, one per index, so push
+// and pop are a single CAS on the head and never allocate. The head packs the
+// top index with a counter bumped on every change, so a pop that raced with a
+// pop + push of the same index fails its CAS instead of corrupting the links.
+// Each index is on the stack at most once: push() of a queued index is a no-op.
+// The stack only records candidates - the caller still claims the slot itself.
+class FreeSlotStack {
+private:
+    static constexpr uint32_t EMPTY = 0xFFFFFFFFu;
+
+    std::unique_ptr<std::atomic<uint32_t>[]> next;
+    std::unique_ptr<std::atomic<bool>[]> queued;
+    int capacity;
+    int indexCount;
+    std::atomic<uint64_t> head;   // High 32 bits: change counter, low 32 bits: top index or EMPTY
+
+    static uint64_t pack(uint64_t tag, uint32_t index) {
+        return (tag << 32) | index;
+    }
+
+public:
+    FreeSlotStack() : capacity(0), indexCount(0), head(pack(0, EMPTY)) {}
+    FreeSlotStack(const FreeSlotStack&) = delete;
+    FreeSlotStack& operator=(const FreeSlotStack&) = delete;
+
+    // Make room for one more index (slots are only ever appended, before the zone is shared)
+    void addIndex() {
+        if (indexCount == capacity) {
+            int newCapacity = capacity == 0 ? 64 : capacity * 2;
+            std::unique_ptr<std::atomic<uint32_t>[]> grownNext(new std::atomic<uint32_t>[newCapacity]);
+            std::unique_ptr<std::atomic<bool>[]> grownQueued(new std::atomic<bool>[newCapacity]);
+            for (int i = 0; i < newCapacity; i++) {
+                grownNext[i].store(i < indexCount ? next[i].load() : EMPTY, std::memory_order_relaxed);
+                grownQueued[i].store(i < indexCount && queued[i].load(), std::memory_order_relaxed);
+            }
+            next = std::move(grownNext);
+            queued = std::move(grownQueued);
+            capacity = newCapacity;
+        }
+        indexCount++;
+    }
+
+    // O(1); false if the index was already queued
+    bool push(int index) {
+        if (queued[index].exchange(true)) return false;
+        uint64_t top = head.load();
+        do {
+            next[index].store((uint32_t)top);
+        } while (!head.compare_exchange_weak(top, pack((top >> 32) + 1, (uint32_t)index)));
+        return true;
+    }
+
+    // O(1); the most recently pushed index, or -1 if the stack is empty
+    int pop() {
+        uint64_t top = head.load();
+        while ((uint32_t)top != EMPTY) {
+            uint32_t index = (uint32_t)top;
+            // May read a link rewritten by a racing push; the counter then fails the CAS
+            uint64_t below = next[index].load();
+            if (head.compare_exchange_weak(top, pack((top >> 32) + 1, (uint32_t)below))) {
+                queued[index].store(false);
+                return (int)index;
+            }
+        }
+        return -1;
+    }
+
+    bool isEmpty() const {
+        return (uint32_t)head.load() == EMPTY;
+    }
+};
+
+#endif // FREESLOTSTACK_H
@@ -0,0 +1,161 @@
+#ifndef HASHINDEX_H
+#define HASHINDEX_H
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// HASH INDEX TEMPLATE CLASS (Open addressing, linear probing)
+// ============================================================================
+// Flat key -> value table. Each bucket caches its key's hash so probes only
+// compare keys when the hashes already match. Erased buckets become
+// tombstones and are cleaned up on the next rehash.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class HashIndex {
+private:
+    enum class BucketState : unsigned char { EMPTY, OCCUPIED, TOMBSTONE };
+
+    struct Bucket {
+        Key key;
+        Value value;
+        size_t hash;
+        BucketState state;
+
+        Bucket() : key(), value(), hash(0), state(BucketState::EMPTY) {}
+    };
+
+    std::vector<Bucket> buckets;
+    int size;
+    int tombstones;
+    Hash hasher;
+
+    static const int INITIAL_CAPACITY = 16;   // Must be a power of two
+
+    size_t mask() const {
+        return buckets.size() - 1;
+    }
+
+    // Bucket index holding key, or -1
+    long findIndex(const Key& key, size_t hash) const {
+        if (buckets.empty()) return -1;
+        size_t index = hash & mask();
+        while (true) {
+            const Bucket& bucket = buckets[index];
+            if (bucket.state == BucketState::EMPTY) return -1;
+            if (bucket.state == BucketState::OCCUPIED && bucket.hash == hash && bucket.key == key) {
+                return static_cast<long>(index);
+            }
+            index = (index + 1) & mask();
+        }
+    }
+
+    // Keep (size + tombstones) below 70% so probe chains stay short
+    void reserveForInsert() {
+        if (buckets.empty()) {
+            buckets.resize(INITIAL_CAPACITY);
+            return;
+        }
+        if ((size + tombstones + 1) * 10 >= static_cast<int>(buckets.size()) * 7) {
+            size_t newCapacity = buckets.size();
+            if ((size + 1) * 10 >= static_cast<int>(buckets.size()) * 5) {
+                newCapacity *= 2;   // Grow; otherwise just purge tombstones
+            }
+            rehash(newCapacity);
+        }
+    }
+
+    void rehash(size_t newCapacity) {
+        std::vector<Bucket> old(newCapacity);
+        old.swap(buckets);
+        tombstones = 0;
+        for (Bucket& bucket : old) {
+            if (bucket.state != BucketState::OCCUPIED) continue;
+            size_t index = bucket.hash & mask();
+            while (buckets[index].state == BucketState::OCCUPIED) {
+                index = (index + 1) & mask();
+            }
+            buckets[index] = std::move(bucket);
+        }
+    }
+
+public:
+    // Constructor
+    HashIndex() : size(0), tombstones(0) {}
+
+    // ========================================================================
+    // INDEX OPERATIONS
+    // ========================================================================
+
+    // Insert key -> value; returns false (and changes nothing) if key exists
+    bool insert(const Key& key, const Value& value) {
+        size_t hash = hasher(key);
+        if (findIndex(key, hash) != -1) return false;
+
+        reserveForInsert();
+        size_t index = hash & mask();
+        while (buckets[index].state == BucketState::OCCUPIED) {
+            index = (index + 1) & mask();
+        }
+        Bucket& bucket = buckets[index];
+        if (bucket.state == BucketState::TOMBSTONE) tombstones--;
+        bucket.key = key;
+        bucket.value = value;
+        bucket.hash = hash;
+        bucket.state = BucketState::OCCUPIED;
+        size++;
+        return true;
+    }
+
+    // Pointer to the value stored for key, or nullptr
+    Value* find(const Key& key) {
+        long index = findIndex(key, hasher(key));
+        return index == -1 ? nullptr : &buckets[index].value;
+    }
+
+    const Value* find(const Key& key) const {
+        long index = findIndex(key, hasher(key));
+        return index == -1 ? nullptr : &buckets[index].value;
+    }
+
+    bool contains(const Key& key) const {
+        return find(key) != nullptr;
+    }
+
+    // Remove key; returns false if it was not present
+    bool erase(const Key& key) {
+        long index = findIndex(key, hasher(key));
+        if (index == -1) return false;
+        Bucket& bucket = buckets[index];
+        bucket.state = BucketState::TOMBSTONE;
+        bucket.key = Key();
+        bucket.value = Value();
+        size--;
+        tombstones++;
+        return true;
+    }
+
+    void clear() {
+        buckets.clear();
+        size = 0;
+        tombstones = 0;
+    }
+
+    // ========================================================================
+    // GETTERS
+    // ========================================================================
+    int getSize() const {
+        return size;
+    }
+
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    int getCapacity() const {
+        return static_cast<int>(buckets.size());
+    }
+};
+
+#endif // HASHINDEX_H
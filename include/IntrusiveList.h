@@ -0,0 +1,170 @@
+#ifndef INTRUSIVELIST_H
+#define INTRUSIVELIST_H
+
+#include <cstddef>
+#include <iterator>
+
+// ============================================================================
+// INTRUSIVE LIST HOOK
+// ============================================================================
+// Embedded in the element itself, so linking/unlinking allocates nothing and
+// an element can be removed in O(1) given only its pointer.
+template <typename T>
+struct IntrusiveListHook {
+    T* prev;
+    T* next;
+    bool linked;
+
+    IntrusiveListHook() : prev(nullptr), next(nullptr), linked(false) {}
+};
+
+// ============================================================================
+// INTRUSIVE DOUBLY LINKED LIST TEMPLATE CLASS
+// ============================================================================
+// T must provide: IntrusiveListHook<T>& listHook();
+// An element can be in at most one IntrusiveList at a time. The list does
+// not own its elements.
+template <typename T>
+class IntrusiveList {
+private:
+    T* head;
+    T* tail;
+    int size;
+
+public:
+    // Constructor
+    IntrusiveList() : head(nullptr), tail(nullptr), size(0) {}
+
+    // Elements point back into the list, so it cannot be copied
+    IntrusiveList(const IntrusiveList&) = delete;
+    IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+    // Destructor - unlinks remaining elements
+    ~IntrusiveList() {
+        clear();
+    }
+
+    // ========================================================================
+    // BASIC OPERATIONS
+    // ========================================================================
+
+    // Link element at the end; no-op if it is already linked
+    void insertBack(T* element) {
+        if (element == nullptr) return;
+        IntrusiveListHook<T>& hook = element->listHook();
+        if (hook.linked) return;
+
+        hook.prev = tail;
+        hook.next = nullptr;
+        hook.linked = true;
+        if (tail != nullptr) {
+            tail->listHook().next = element;
+        } else {
+            head = element;
+        }
+        tail = element;
+        size++;
+    }
+
+    // Unlink element in O(1); returns false if it was not linked
+    bool remove(T* element) {
+        if (element == nullptr) return false;
+        IntrusiveListHook<T>& hook = element->listHook();
+        if (!hook.linked) return false;
+
+        if (hook.prev != nullptr) {
+            hook.prev->listHook().next = hook.next;
+        } else {
+            head = hook.next;
+        }
+        if (hook.next != nullptr) {
+            hook.next->listHook().prev = hook.prev;
+        } else {
+            tail = hook.prev;
+        }
+
+        hook.prev = nullptr;
+        hook.next = nullptr;
+        hook.linked = false;
+        size--;
+        return true;
+    }
+
+    // O(1) membership test (valid because an element is in at most one list)
+    bool contains(T* element) const {
+        return element != nullptr && element->listHook().linked;
+    }
+
+    void clear() {
+        while (head != nullptr) {
+            remove(head);
+        }
+    }
+
+    // ========================================================================
+    // GETTERS
+    // ========================================================================
+    int getSize() const {
+        return size;
+    }
+
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    // ========================================================================
+    // ITERATION SUPPORT
+    // ========================================================================
+
+    // Manual iteration; save getNext() before removing the current element
+    T* getHead() const {
+        return head;
+    }
+
+    T* getTail() const {
+        return tail;
+    }
+
+    static T* getNext(T* element) {
+        return element->listHook().next;
+    }
+
+    // Forward iterator yielding element pointers (range-for friendly)
+    class iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef T* const* pointer;
+        typedef T* reference;
+
+    private:
+        T* current;
+
+    public:
+        explicit iterator(T* element = nullptr) : current(element) {}
+
+        reference operator*() const { return current; }
+
+        iterator& operator++() {
+            current = current->listHook().next;
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator previous = *this;
+            current = current->listHook().next;
+            return previous;
+        }
+
+        bool operator==(const iterator& other) const { return current == other.current; }
+        bool operator!=(const iterator& other) const { return current != other.current; }
+    };
+
+    typedef iterator const_iterator;
+
+    iterator begin() const { return iterator(head); }
+    iterator end() const { return iterator(nullptr); }
+};
+
+#endif // INTRUSIVELIST_H
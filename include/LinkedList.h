@@ -2,16 +2,20 @@
 #define LINKEDLIST_H
 
 #include "Node.h"
+#include "NodeIterator.h"
+#include "NodePool.h"
 
 // ============================================================================
 // DOUBLY LINKED LIST TEMPLATE CLASS
 // ============================================================================
-template <typename T>
+// Allocator: HeapNodeAllocator<T> (default) or PooledNodeAllocator<T>
+template <typename T, typename Allocator = HeapNodeAllocator<T>>
 class DoublyLinkedList {
 private:
     Node<T>* head;
     Node<T>* tail;
     int size;
+    Allocator allocator;
 
 public:
     // Constructor
@@ -39,7 +43,7 @@ public:
     }
 
     DoublyLinkedList(DoublyLinkedList&& other) noexcept
-        : head(other.head), tail(other.tail), size(other.size) {
+        : head(other.head), tail(other.tail), size(other.size), allocator(std::move(other.allocator)) {
         other.head = nullptr;
         other.tail = nullptr;
         other.size = 0;
@@ -51,6 +55,7 @@ public:
             head = other.head;
             tail = other.tail;
             size = other.size;
+            allocator = std::move(other.allocator);
             other.head = nullptr;
             other.tail = nullptr;
             other.size = 0;
@@ -69,8 +74,40 @@ public:
     
     // Insert at the beginning
     void insertFront(const T& value) {
-        Node<T>* newNode = new Node<T>(value);
-        
+        linkFront(allocator.create(value));
+    }
+    
+    void insertFront(T&& value) {
+        linkFront(allocator.create(std::move(value)));
+    }
+    
+    // Construct element in place at the beginning
+    template <typename... Args>
+    T& emplaceFront(Args&&... args) {
+        Node<T>* newNode = allocator.create(std::in_place, std::forward<Args>(args)...);
+        linkFront(newNode);
+        return newNode->data;
+    }
+    
+    // Insert at the end
+    void insertBack(const T& value) {
+        linkBack(allocator.create(value));
+    }
+    
+    void insertBack(T&& value) {
+        linkBack(allocator.create(std::move(value)));
+    }
+    
+    // Construct element in place at the end
+    template <typename... Args>
+    T& emplaceBack(Args&&... args) {
+        Node<T>* newNode = allocator.create(std::in_place, std::forward<Args>(args)...);
+        linkBack(newNode);
+        return newNode->data;
+    }
+
+private:
+    void linkFront(Node<T>* newNode) {
         if (head == nullptr) {
             head = tail = newNode;
         } else {
@@ -81,10 +118,7 @@ public:
         size++;
     }
     
-    // Insert at the end
-    void insertBack(const T& value) {
-        Node<T>* newNode = new Node<T>(value);
-        
+    void linkBack(Node<T>* newNode) {
         if (tail == nullptr) {
             head = tail = newNode;
         } else {
@@ -94,7 +128,8 @@ public:
         }
         size++;
     }
-    
+
+public:
     // Remove from the beginning
     void removeFront() {
         if (head == nullptr) return;
@@ -108,7 +143,7 @@ public:
             tail = nullptr;
         }
         
-        delete temp;
+        allocator.destroy(temp);
         size--;
     }
     
@@ -125,7 +160,7 @@ public:
             head = nullptr;
         }
         
-        delete temp;
+        allocator.destroy(temp);
         size--;
     }
     
@@ -216,7 +251,7 @@ public:
             tail = node->prev;
         }
         
-        delete node;
+        allocator.destroy(node);
         size--;
     }
     
@@ -233,6 +268,17 @@ public:
     Node<T>* getTail() const {
         return tail;
     }
+
+    // STL-style iteration (range-for and <algorithm>)
+    typedef NodeIterator<T, false> iterator;
+    typedef NodeIterator<T, true> const_iterator;
+
+    iterator begin() { return iterator(head, tail); }
+    iterator end() { return iterator(nullptr, tail); }
+    const_iterator begin() const { return const_iterator(head, tail); }
+    const_iterator end() const { return const_iterator(nullptr, tail); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
     
     // Print the list (requires operator<< for type T)
     void printForward() const {
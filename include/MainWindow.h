@@ -13,6 +13,7 @@
 #include <QProgressBar>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
+#include <QTimer>
 
 // Forward declarations to avoid MOC issues
 class ParkingSystem;
@@ -39,6 +40,7 @@ private slots:
     void onShowZoneAnalytics();
     void onShowFullHistory();
     void onDashboardTabChanged(int index);
+    void onPublishTimer();   // Publishes the dashboard if anything changed
     
     // Rollback Slots
     void onRollbackOperations();
@@ -63,6 +65,10 @@ private:
     // Parking System
     ParkingSystem* parkingSystem;
     
+    // Dashboard publishing (throttled; see onPublishTimer)
+    static const int PUBLISH_INTERVAL_MS = 250;
+    QTimer* publishTimer;
+    
     // =====================================================
     // ZONE MANAGEMENT WIDGETS
     // =====================================================
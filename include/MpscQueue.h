@@ -0,0 +1,74 @@
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include <atomic>
+#include <utility>
+
+// ============================================================================
+// MPSC QUEUE TEMPLATE CLASS (Lock-free, many producers, one consumer)
+// ============================================================================
+// Unbounded intrusive queue after Vyukov: push() is one atomic exchange on the
+// tail plus one store, so producers never lock and never wait for each other.
+// Only one thread may call tryPop(). A push that has swapped the tail but not
+// yet linked its node is invisible for that instant; tryPop() then reports
+// empty and the consumer simply sees the element on its next call.
+template <typename T>
+class MpscQueue {
+private:
+    struct QueueNode {
+        std::atomic<QueueNode*> next;
+        T value;
+
+        QueueNode() : next(nullptr), value() {}
+        explicit QueueNode(T&& v) : next(nullptr), value(std::move(v)) {}
+    };
+
+    std::atomic<QueueNode*> tail;   // Producers append here
+    QueueNode* head;                // Consumer-owned; always the current stub node
+
+public:
+    // Constructor
+    MpscQueue() : tail(nullptr), head(new QueueNode()) {
+        tail.store(head);
+    }
+
+    // Destructor (no producer or consumer may still be running)
+    ~MpscQueue() {
+        while (head != nullptr) {
+            QueueNode* next = head->next.load();
+            delete head;
+            head = next;
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // ========================================================================
+    // QUEUE OPERATIONS
+    // ========================================================================
+
+    // Any thread - O(1), lock-free
+    void push(T value) {
+        QueueNode* node = new QueueNode(std::move(value));
+        QueueNode* previous = tail.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node);   // seq_cst: pairs with isEmpty() for sleep/wake handshakes
+    }
+
+    // Consumer thread only - O(1); false if nothing is ready
+    bool tryPop(T& out) {
+        QueueNode* next = head->next.load(std::memory_order_acquire);
+        if (next == nullptr) return false;
+        out = std::move(next->value);
+        delete head;   // Old stub; next becomes the new one
+        head = next;
+        return true;
+    }
+
+    // Consumer thread only; a concurrent push may make this stale at once
+    bool isEmpty() const {
+        return head->next.load() == nullptr;
+    }
+};
+
+#endif // MPSCQUEUE_H
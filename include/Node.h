@@ -1,6 +1,8 @@
 #ifndef NODE_H
 #define NODE_H
 
+#include <utility>
+
 // ============================================================================
 // DOUBLY LINKED LIST NODE
 // ============================================================================
@@ -10,8 +12,13 @@ struct Node {
     Node<T>* next;
     Node<T>* prev;
     
-    // Constructor
+    // Constructors (copy, move, or construct data in place)
     Node(const T& value) : data(value), next(nullptr), prev(nullptr) {}
+    Node(T&& value) : data(std::move(value)), next(nullptr), prev(nullptr) {}
+
+    template <typename... Args>
+    explicit Node(std::in_place_t, Args&&... args)
+        : data(std::forward<Args>(args)...), next(nullptr), prev(nullptr) {}
     
     // Destructor
     ~Node() {}
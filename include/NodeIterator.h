@@ -0,0 +1,69 @@
+#ifndef NODEITERATOR_H
+#define NODEITERATOR_H
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include "Node.h"
+
+// ============================================================================
+// BIDIRECTIONAL NODE ITERATOR
+// ============================================================================
+// Shared by DoublyLinkedList<T>, SlotMap<T> and Stack<T>. Walks the
+// next/prev links; end() is a null node that remembers the last node so
+// that --end() works as required for bidirectional iterators.
+template <typename T, bool IsConst>
+class NodeIterator {
+public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef typename std::conditional<IsConst, const T*, T*>::type pointer;
+    typedef typename std::conditional<IsConst, const T&, T&>::type reference;
+
+private:
+    Node<T>* node;
+    Node<T>* last;
+
+public:
+    NodeIterator() : node(nullptr), last(nullptr) {}
+    NodeIterator(Node<T>* current, Node<T>* lastNode) : node(current), last(lastNode) {}
+
+    // iterator -> const_iterator conversion
+    template <bool OtherConst, typename = typename std::enable_if<IsConst && !OtherConst>::type>
+    NodeIterator(const NodeIterator<T, OtherConst>& other) : node(other.getNode()), last(other.getLast()) {}
+
+    reference operator*() const { return node->data; }
+    pointer operator->() const { return &node->data; }
+
+    NodeIterator& operator++() {
+        node = node->next;
+        return *this;
+    }
+
+    NodeIterator operator++(int) {
+        NodeIterator previous = *this;
+        node = node->next;
+        return previous;
+    }
+
+    NodeIterator& operator--() {
+        node = (node == nullptr) ? last : node->prev;
+        return *this;
+    }
+
+    NodeIterator operator--(int) {
+        NodeIterator previous = *this;
+        --(*this);
+        return previous;
+    }
+
+    bool operator==(const NodeIterator& other) const { return node == other.node; }
+    bool operator!=(const NodeIterator& other) const { return node != other.node; }
+
+    // Underlying node, e.g. for removeNode()
+    Node<T>* getNode() const { return node; }
+    Node<T>* getLast() const { return last; }
+};
+
+#endif // NODEITERATOR_H
@@ -0,0 +1,141 @@
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include <new>
+#include <utility>
+#include <vector>
+#include "Node.h"
+
+// ============================================================================
+// NODE ALLOCATORS FOR DoublyLinkedList<T> AND Stack<T>
+// ============================================================================
+// Allocator interface used by the container templates:
+//   Node<T>* create(Args&&... args);   // construct a detached node, forwarding
+//                                      // args to a Node<T> constructor
+//   void destroy(Node<T>* node);       // destroy a node from create()
+//
+// Allocators are owned by a single container, so they are not shared
+// between lists; copying a container gives the copy its own allocator.
+
+// ============================================================================
+// HEAP NODE ALLOCATOR (default - one new/delete per node)
+// ============================================================================
+template <typename T>
+struct HeapNodeAllocator {
+    template <typename... Args>
+    Node<T>* create(Args&&... args) {
+        return new Node<T>(std::forward<Args>(args)...);
+    }
+
+    void destroy(Node<T>* node) {
+        delete node;
+    }
+};
+
+// ============================================================================
+// POOLED NODE ALLOCATOR (free-list reuse, one heap block per BlockSize nodes)
+// ============================================================================
+template <typename T, int BlockSize = 64>
+class PooledNodeAllocator {
+private:
+    // Raw storage for one node; while free, the first bytes hold the
+    // free-list link instead of a live Node<T>
+    union NodeStorage {
+        NodeStorage* nextFree;
+        alignas(Node<T>) unsigned char bytes[sizeof(Node<T>)];
+    };
+
+    std::vector<NodeStorage*> blocks;
+    NodeStorage* freeList;
+    int usedInLastBlock;   // Bump index into the newest block
+    int liveNodes;
+
+    NodeStorage* acquire() {
+        if (freeList != nullptr) {
+            NodeStorage* storage = freeList;
+            freeList = freeList->nextFree;
+            return storage;
+        }
+        if (blocks.empty() || usedInLastBlock == BlockSize) {
+            blocks.push_back(static_cast<NodeStorage*>(::operator new(sizeof(NodeStorage) * BlockSize)));
+            usedInLastBlock = 0;
+        }
+        return &blocks.back()[usedInLastBlock++];
+    }
+
+    void releaseBlocks() {
+        for (NodeStorage* block : blocks) {
+            ::operator delete(block);
+        }
+        blocks.clear();
+        freeList = nullptr;
+        usedInLastBlock = 0;
+    }
+
+public:
+    PooledNodeAllocator() : freeList(nullptr), usedInLastBlock(0), liveNodes(0) {}
+
+    // A copied container starts with an empty pool of its own
+    PooledNodeAllocator(const PooledNodeAllocator&) : PooledNodeAllocator() {}
+    PooledNodeAllocator& operator=(const PooledNodeAllocator&) { return *this; }
+
+    // Moving a container moves its nodes, so the pool must follow them
+    PooledNodeAllocator(PooledNodeAllocator&& other) noexcept
+        : blocks(std::move(other.blocks)), freeList(other.freeList),
+          usedInLastBlock(other.usedInLastBlock), liveNodes(other.liveNodes) {
+        other.blocks.clear();
+        other.freeList = nullptr;
+        other.usedInLastBlock = 0;
+        other.liveNodes = 0;
+    }
+
+    PooledNodeAllocator& operator=(PooledNodeAllocator&& other) noexcept {
+        if (this != &other) {
+            releaseBlocks();
+            blocks = std::move(other.blocks);
+            freeList = other.freeList;
+            usedInLastBlock = other.usedInLastBlock;
+            liveNodes = other.liveNodes;
+            other.blocks.clear();
+            other.freeList = nullptr;
+            other.usedInLastBlock = 0;
+            other.liveNodes = 0;
+        }
+        return *this;
+    }
+
+    // Owning container must destroy all nodes before the pool goes away
+    ~PooledNodeAllocator() {
+        releaseBlocks();
+    }
+
+    template <typename... Args>
+    Node<T>* create(Args&&... args) {
+        NodeStorage* storage = acquire();
+        Node<T>* node = new (storage->bytes) Node<T>(std::forward<Args>(args)...);
+        liveNodes++;
+        return node;
+    }
+
+    void destroy(Node<T>* node) {
+        if (node == nullptr) return;
+        node->~Node<T>();
+        NodeStorage* storage = reinterpret_cast<NodeStorage*>(node);
+        storage->nextFree = freeList;
+        freeList = storage;
+        liveNodes--;
+    }
+
+    // ========================================================================
+    // POOL STATISTICS
+    // ========================================================================
+    int getLiveNodes() const {
+        return liveNodes;
+    }
+
+    int getBlockCount() const {
+        return static_cast<int>(blocks.size());
+    }
+};
+
+#endif // NODEPOOL_H
@@ -1,10 +1,15 @@
 #ifndef PARKINGAREA_H
 #define PARKINGAREA_H
 
+#include <atomic>
 #include <cstdint>
+#include "Common.h"
 
-// Forward declarations only - no includes to avoid MOC issues
+// Forward declarations
 class ParkingSlot;
+class AtomicSlotBitmap;
+class SlotBitmap;
+class Zone;
 
 // ============================================================================
 // PARKING AREA CLASS
@@ -13,8 +18,15 @@ class ParkingArea {
 private:
     int areaID;
     intptr_t slotsPtr;  // Opaque pointer to std::vector<ParkingSlot*>
+    AtomicSlotBitmap* availability;         // Bit i set = slot i is free
+    AtomicSlotBitmap* availabilityBySize;   // [SLOT_SIZE_COUNT] bitmaps, bit i set = slot i is free and of that size
     int totalSlots;
-    int availableSlots;
+    std::atomic<int> availableSlots;   // Maintained on every slot state change
+    int totalBySize[SLOT_SIZE_COUNT];
+    std::atomic<int> availableBySize[SLOT_SIZE_COUNT];
+    Zone* ownerZone;   // Set by assignLocation() when attached to a zone
+    int ownerZoneID;
+    int areaIndex;     // Position of this area inside its zone (-1 if unattached)
 
 public:
     // Constructor
@@ -27,8 +39,18 @@ public:
     // SLOT MANAGEMENT
     // ========================================================================
     void addSlot(ParkingSlot* slot);
-    ParkingSlot* findAvailableSlot();
+    // Bitmap scans, O(S/64) words for S slots (the zone keeps the free-slot stacks)
+    ParkingSlot* findAvailableSlot();                 // Lowest free slot of any size
+    ParkingSlot* findAvailableSlot(SlotSize size);    // Lowest free slot of exactly this size
+    ParkingSlot* claimAvailableSlot(SlotSize size);   // Lock-free find + allocate(); nullptr if none left
     ParkingSlot* findSlotByID(int slotID);
+    ParkingSlot* getSlotAt(int slotIndex) const;   // O(1), used to resolve SlotHandles
+    void assignLocation(Zone* zone, int indexInZone);
+    
+    // Called by ParkingSlot::allocate()/free() to keep the bitmap in sync
+    void markSlotOccupied(int slotIndex, SlotSize size);
+    void markSlotAvailable(int slotIndex, SlotSize size);
+    void offerFreeSlot(int slotIndex);   // After free() has made the slot claimable again
     
     // ========================================================================
     // GETTERS
@@ -36,12 +58,16 @@ public:
     int getAreaID() const;
     int getTotalSlots() const;
     int getAvailableSlots() const;
+    int getTotalSlots(SlotSize size) const;
+    int getAvailableSlots(SlotSize size) const;
+    int getAreaIndex() const;
+    SlotBitmap copyAvailabilityBitmap(SlotSize size) const;   // Point-in-time copy, for snapshots
     
     // ========================================================================
     // UTILITY METHODS
     // ========================================================================
     void displayInfo() const;
-    void refreshAvailableCount();
+    void refreshAvailableCount();   // Full recount from the bitmap (consistency check only)
 };
 
 #endif // PARKINGAREA_H
@@ -1,8 +1,10 @@
 #ifndef PARKINGREQUEST_H
 #define PARKINGREQUEST_H
 
+#include <atomic>
 #include <string>
 #include "Common.h"
+#include "IntrusiveList.h"
 
 // ============================================================================
 // PARKING REQUEST CLASS
@@ -11,17 +13,20 @@ class ParkingRequest {
 private:
     std::string vehicleID;
     int requestedZoneID;
-    int allocatedSlotID;
+    VehicleType vehicleType;         // Decides the slot size class
+    int allocatedSlotID;             // Slot number for display (not unique across zones)
+    SlotHandle allocatedSlotHandle;  // Unique slot address used to free the slot
     DateTime requestTime;
-    RequestState currentStatus;
+    std::atomic<RequestState> currentStatus;   // Atomic so reports can read it under the shared system lock
     double penaltyCost;
+    IntrusiveListHook<ParkingRequest> activeHook;  // Membership in ParkingSystem::activeRequests
     
     // Valid state transitions map
     bool isValidTransition(RequestState from, RequestState to);
 
 public:
     // Constructor
-    ParkingRequest(const std::string& vID, int zoneID);
+    ParkingRequest(std::string vID, int zoneID, VehicleType type = VehicleType::SEDAN);
     
     // Destructor
     ~ParkingRequest();
@@ -34,9 +39,11 @@ public:
     // ========================================================================
     // GETTERS
     // ========================================================================
-    std::string getVehicleID() const;
+    const std::string& getVehicleID() const;
     int getRequestedZoneID() const;
+    VehicleType getVehicleType() const;
     int getAllocatedSlotID() const;
+    SlotHandle getAllocatedSlotHandle() const;
     DateTime getRequestTime() const;
     RequestState getCurrentStatus() const;
     double getPenaltyCost() const;
@@ -47,6 +54,14 @@ public:
     void setPenaltyCost(double cost);
     void addPenaltyCost(double cost);
     void setAllocatedSlotID(int slotID);
+    void setAllocatedSlot(int slotID, SlotHandle handle);
+    void clearAllocatedSlot();
+    
+    // ========================================================================
+    // ACTIVE LIST MEMBERSHIP (used by IntrusiveList<ParkingRequest>)
+    // ========================================================================
+    IntrusiveListHook<ParkingRequest>& listHook();
+    bool isInActiveList() const;
     
     // ========================================================================
     // UTILITY METHODS
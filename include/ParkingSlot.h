@@ -1,18 +1,33 @@
 #ifndef PARKINGSLOT_H
 #define PARKINGSLOT_H
 
+#include <atomic>
+#include "Common.h"
+
+class ParkingArea;
+
 // ============================================================================
 // PARKING SLOT CLASS
 // ============================================================================
 class ParkingSlot {
 private:
+    // Claim and release go through a transient state, so the area's bitmaps
+    // and counters are updated by one thread at a time per slot: a slot being
+    // released cannot be claimed until the release has finished, and vice versa
+    enum SlotState { FREE, CLAIMING, OCCUPIED, RELEASING };
+
     int slotID;
     int zoneID;
-    bool isAvailable;
+    std::atomic<int> state;   // SlotState, changed by compare-and-swap
+    SlotSize size;
+    SlotHandle handle;   // Assigned when the slot's area is attached to a zone
+    ParkingArea* ownerArea;   // Notified on allocate()/free() (nullptr if standalone)
+    int indexInArea;
+    int zoneSlotIndex;   // Index in the owning zone's free-slot stacks (-1 until registered)
 
 public:
     // Constructor
-    ParkingSlot(int id, int zone);
+    ParkingSlot(int id, int zone, SlotSize slotSize = SlotSize::STANDARD);
     
     // Destructor
     ~ParkingSlot();
@@ -23,12 +38,19 @@ public:
     int getSlotID() const;
     int getZoneID() const;
     bool getIsAvailable() const;
+    SlotSize getSize() const;
+    SlotHandle getHandle() const;
+    void setHandle(SlotHandle slotHandle);
+    void attachToArea(ParkingArea* area, int index);
+    int getZoneSlotIndex() const;
+    void setZoneSlotIndex(int index);
     
     // ========================================================================
     // SLOT MANAGEMENT
     // ========================================================================
-    bool allocate();
-    void free();
+    bool allocate();   // Atomic claim: exactly one of several racing callers gets true
+    void free();       // Atomic release; a no-op if the slot is already free
+                       // Offers the slot back to its zone's free-slot stack once it is FREE
     
     // ========================================================================
     // UTILITY METHODS
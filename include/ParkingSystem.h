@@ -1,14 +1,31 @@
 #ifndef PARKINGSYSTEM_H
 #define PARKINGSYSTEM_H
 
+#include <atomic>
+#include <ctime>
+#include <functional>
 #include <iostream>
 #include <iomanip>
+#include <mutex>
+#include <queue>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include "LinkedList.h"
+#include "SlotMap.h"
+#include "IntrusiveList.h"
+#include "HashIndex.h"
+#include "StripedHashIndex.h"
 #include "Zone.h"
 #include "Vehicle.h"
 #include "ParkingRequest.h"
 #include "AllocationEngine.h"
+#include "AllocationSnapshot.h"
 #include "RollbackManager.h"
+#include "SnapshotPublisher.h"
+#include "WorkStealingPool.h"
 
 // ============================================================================
 // ZONE SLOT STATUS STRUCT
@@ -19,6 +36,38 @@ struct ZoneSlotStatus {
     int availableSlots;
     int occupiedSlots;
     double utilization;
+    
+    ZoneSlotStatus() : zoneID(0), totalSlots(0), availableSlots(0), occupiedSlots(0), utilization(0.0) {}
+    
+    // Derives occupied count and utilization from total/available
+    ZoneSlotStatus(int id, int total, int available)
+        : zoneID(id), totalSlots(total), availableSlots(available), occupiedSlots(total - available),
+          utilization(total > 0 ? (100.0 * (total - available) / total) : 0.0) {}
+};
+
+// ============================================================================
+// BATCH ARRIVAL STRUCT
+// ============================================================================
+struct BatchArrival {
+    std::string vehicleID;
+    int zoneID;                // Preferred zone
+    VehicleType vehicleType;
+    
+    BatchArrival(const std::string& id, int zone, VehicleType type = VehicleType::SEDAN)
+        : vehicleID(id), zoneID(zone), vehicleType(type) {}
+};
+
+// ============================================================================
+// BATCH ALLOCATION RESULT STRUCT
+// ============================================================================
+struct BatchAllocationResult {
+    std::string vehicleID;
+    bool allocated;
+    int zoneID;          // Zone the slot came from (-1 if not allocated)
+    int slotID;          // -1 if not allocated
+    double penaltyCost;  // Cross-zone penalty charged, if any
+    
+    BatchAllocationResult() : allocated(false), zoneID(-1), slotID(-1), penaltyCost(0.0) {}
 };
 
 // ============================================================================
@@ -34,7 +83,11 @@ struct DashboardStats {
     double averageParkingDuration;
     int totalZones;
     double systemUtilization;
-    DoublyLinkedList<ZoneSlotStatus> zoneStatuses;  // Detailed slot info per zone
+    int mostAvailableZoneID;      // Zone with the most free slots (-1 if every zone is full)
+    int mostAvailableZoneSlots;
+    // Detailed slot info per zone. Rebuilt on every dashboard computation (each
+    // publish), so nodes come from a pool: one heap block per 64 zones
+    DoublyLinkedList<ZoneSlotStatus, PooledNodeAllocator<ZoneSlotStatus>> zoneStatuses;
     
     void display() const {
         std::cout << "\n========== DASHBOARD STATISTICS ==========" << std::endl;
@@ -46,28 +99,82 @@ struct DashboardStats {
         std::cout << "Average Duration: " << averageParkingDuration << " minutes" << std::endl;
         std::cout << "Total Zones: " << totalZones << std::endl;
         std::cout << "System Utilization: " << systemUtilization << "%" << std::endl;
+        if (mostAvailableZoneID != -1) {
+            std::cout << "Most Available Zone: " << mostAvailableZoneID
+                      << " (" << mostAvailableZoneSlots << " free)" << std::endl;
+        }
         std::cout << "========================================\n" << std::endl;
     }
 };
 
+// Immutable, versioned dashboard view handed out by getPublishedDashboard()
+typedef SnapshotPublisher<DashboardStats>::Handle DashboardSnapshot;
+
 // ============================================================================
 // PARKING SYSTEM CLASS (Controller Pattern - Qt-Ready)
 // ============================================================================
 class ParkingSystem {
 private:
+    // Work unit sizes for parallel dashboard aggregation
+    static const int HISTORY_SLOTS_PER_CHUNK = 16384;
+    static const int ZONES_PER_CHUNK = 64;
+    
+    typedef std::pair<time_t, Zone*> ReservationWakeup;   // When a zone's reservation book next has work
+    
     AllocationEngine* engine;
     RollbackManager* rollbackManager;
-    DoublyLinkedList<ParkingRequest*> masterHistoryList;  // All requests ever made
-    DoublyLinkedList<ParkingRequest*> activeRequests;      // Currently active requests
+    SlotMap<ParkingRequest*> masterHistoryList;            // All requests ever made
+    IntrusiveList<ParkingRequest> activeRequests;          // Currently active requests (O(1) unlink)
+    StripedHashIndex<std::string, ParkingRequest*> vehicleIndex;   // Vehicle ID -> active request (O(1) lookup)
     DoublyLinkedList<Zone*> zoneCreationHistory;           // Track created zones for rollback
+    std::priority_queue<ReservationWakeup, std::vector<ReservationWakeup>,
+                        std::greater<ReservationWakeup>> reservationWakeups;   // (next start/end, zone), min first
+    std::atomic<time_t> nextReservationWakeup;             // Top of reservationWakeups, max time_t if empty
+    std::unordered_multimap<std::string, Zone*> heldReservationZones;   // Vehicle ID -> zone holding a slot for it
+    std::atomic<int> heldReservationCount;                 // heldReservationZones.size(), read without the lock
+    bool verbose;                                          // Per-operation success logging
+    WorkStealingPool* analyticsPool;                       // Parallel report aggregation (nullptr = serial)
+    SnapshotPublisher<DashboardStats> dashboardPublisher;  // Latest published DashboardStats
+    std::atomic<bool> publishAfterBatch;                   // allocateBatch() publishes on return
+    std::atomic<bool> dashboardDirty;                      // Mutated since the last publish
+    std::mutex publishMutex;                               // One publish at a time, so versions follow state order
+    
+    // Called after every mutation: O(1), and a plain load once already dirty
+    void markDashboardDirty() {
+        if (!dashboardDirty.load()) dashboardDirty.store(true);
+    }
+    
+    // Thread-safe mode (see setThreadSafe): lock order is system, vehicle
+    // stripe, reservation, zone, facility; registry and history locks are innermost
+    bool threadSafe;
+    mutable std::shared_mutex systemMutex;   // Shared: per-vehicle operations; exclusive: structure, rollback, reports
+    mutable std::mutex registryMutex;        // masterHistoryList + activeRequests
+    std::mutex historyMutex;                 // rollbackManager command history
+    std::mutex reservationMutex;             // reservationWakeups + heldReservationZones
     
     // Helper methods
-    ParkingRequest* findRequestByVehicleID(const std::string& vehicleID);
+    ParkingRequest* findRequestByVehicleID(const std::string& vehicleID);   // Caller holds the vehicle's stripe
+    void activateRequest(ParkingRequest* request);     // Link into activeRequests + vehicleIndex
+    void deactivateRequest(ParkingRequest* request);   // Unlink from activeRequests + vehicleIndex
+    void recordCommand(ParkingRequest* request, ParkingSlot* slot, Zone* zone,
+                       RequestState oldState, RequestState newState);
+    void activateDueReservations(time_t now);          // activateReservations() without the system lock
+    void scheduleReservationWakeup(Zone* zone);        // Queue the zone's next event; caller holds reservationMutex
+    ParkingSlot* claimReservedSlot(ParkingRequest* request);   // Slot held for the request's vehicle, or nullptr
+    void runChunks(int chunkCount, const IndexedTask& chunk) const;   // On analyticsPool if set, else inline
+    DashboardStats computeDashboardStats() const;      // getDashboardStats() without the system lock
     double calculateAverageDuration() const;
     
+    // Empty locks unless thread-safe
+    std::shared_lock<std::shared_mutex> lockShared() const;
+    std::unique_lock<std::shared_mutex> lockExclusive() const;
+    std::unique_lock<std::mutex> lockVehicle(const std::string& vehicleID);
+    std::unique_lock<std::mutex> lockRegistry() const;
+    std::unique_lock<std::mutex> lockReservations();
+    
 public:
     // Constructor
-    ParkingSystem();
+    ParkingSystem(int rollbackHistoryDepth = RollbackManager::DEFAULT_HISTORY_DEPTH);
     
     // Destructor
     ~ParkingSystem();
@@ -76,7 +183,9 @@ public:
     // PUBLIC API - SYSTEM INITIALIZATION
     // ========================================================================
     void addZone(Zone* zone);
-    bool createZone(int zoneID, int numSlots);  // Create new zone with rollback support
+    bool createZone(int zoneID, int numSlots);  // Create new zone with rollback support (all STANDARD slots)
+    bool createZone(int zoneID, int compactSlots, int standardSlots, int largeSlots);
+    bool connectZones(int zoneA, int zoneB);    // Declare two zones adjacent (used for overflow order)
     void displaySystemStatus() const;
     
     // ========================================================================
@@ -90,9 +199,11 @@ public:
      * 
      * @param vehicleID - Unique vehicle identifier (must not already exist in active requests)
      * @param preferredZoneID - Zone ID where user wants to park
+     * @param type - Vehicle type; decides the slot size class (best fit)
      * @return ParkingRequest* - The created request, or nullptr if failed (vehicle already has active request)
      */
-    ParkingRequest* createRequest(const std::string& vehicleID, int preferredZoneID);
+    ParkingRequest* createRequest(const std::string& vehicleID, int preferredZoneID,
+                                  VehicleType type = VehicleType::SEDAN);
     
     /**
      * Get active request by vehicle ID
@@ -137,6 +248,84 @@ public:
      */
     bool cancelRequest(const std::string& vehicleID);
     
+    /**
+     * Create and allocate requests for a burst of arrivals in one pass
+     * Arrivals are grouped by preferred zone so each zone is looked up once,
+     * and every command is recorded as a single rollback unit
+     * (rollbackOperations(1) undoes the whole batch, and refuses to once the
+     * batch no longer fits in the rollback history)
+     * 
+     * @param arrivals - Vehicle, preferred zone and type per arrival
+     * @return std::vector<BatchAllocationResult> - One result per arrival, in input order.
+     *         A vehicle that already has an active request, or appeared earlier in
+     *         the batch, is skipped. Slots held by a reservation are handed over
+     *         first; vehicles that got no slot keep a REQUESTED request, as with
+     *         allocateSlotForRequest()
+     */
+    std::vector<BatchAllocationResult> allocateBatch(const std::vector<BatchArrival>& arrivals);
+    
+    /**
+     * Enable or disable per-operation console logging (errors are always printed)
+     */
+    void setVerbose(bool enabled);
+    
+    /**
+     * Choose the allocation policy used by allocateSlotForRequest() and allocateBatch()
+     */
+    void setAllocationPolicy(AllocationPolicyType type);
+    
+    /**
+     * Allow concurrent calls from several threads (e.g. one per gate terminal)
+     * Request operations on different vehicles run in parallel, and allocations
+     * in different zones share no lock beyond the short rollback-history append.
+     * Zone creation, adjacency, reservations, batches, rollback and snapshots
+     * take the system lock exclusively; dashboard reports take it shared.
+     * Switch it on before the system is shared between threads.
+     */
+    void setThreadSafe(bool enabled);
+    
+    /**
+     * Split getDashboardStats() aggregation over a work-stealing pool
+     * History and zones are scanned in chunks on threadCount workers plus the
+     * caller, then reduced in chunk order, so the result matches the serial
+     * scan exactly. 0 (the default) aggregates on the caller alone
+     */
+    void setAnalyticsThreads(int threadCount);
+    
+    /**
+     * Publish a fresh dashboard snapshot at the end of every allocateBatch()
+     * that changed something. Single operations never publish; a
+     * CommandPipeline publishes per drained batch and a UI timer can call
+     * publishIfChanged()
+     */
+    void setPublishAfterBatch(bool enabled);
+    
+    // ========================================================================
+    // PUBLIC API - RESERVATIONS
+    // ========================================================================
+    
+    /**
+     * Book a slot in a zone for the window [start, end)
+     * When the window starts the slot is held, and allocateSlotForRequest()
+     * hands it to the vehicle instead of searching
+     * 
+     * @param vehicleID - Vehicle the slot is booked for
+     * @param zoneID - Zone to book in
+     * @param start, end - Reservation window (end exclusive)
+     * @param type - Vehicle type; decides the slot size class
+     * @return int - Reservation ID (unique within the zone), or -1 if no slot is free for the window
+     */
+    int reserveSlot(const std::string& vehicleID, int zoneID, time_t start, time_t end,
+                    VehicleType type = VehicleType::SEDAN);
+    bool cancelReservation(int zoneID, int reservationID);
+    
+    /**
+     * Hold slots for reservations whose window has started and release holds
+     * that expired unclaimed. Called by allocateSlotForRequest() with the
+     * current time; exposed so a UI timer can drive it as well
+     */
+    void activateReservations(time_t now);
+    
     // ========================================================================
     // PUBLIC API - ROLLBACK OPERATIONS
     // ========================================================================
@@ -161,6 +350,32 @@ public:
      */
     DashboardStats getDashboardStats() const;
     
+    /**
+     * Recompute the dashboard and publish it as a new immutable version
+     * Called by the writer at batch boundaries: allocateBatch() with
+     * setPublishAfterBatch(true), CommandPipeline after every batch it drains,
+     * or an explicit flush. Computed under the shared lock, so writers keep running
+     * 
+     * @return uint64_t - Version number of the published snapshot (1, 2, ...)
+     */
+    uint64_t publishDashboard();
+    
+    /**
+     * publishDashboard(), but only if something changed since the last publish
+     * O(1) when nothing did, so it is cheap to call from a timer
+     * 
+     * @return uint64_t - Version number published, or 0 if the current one is still up to date
+     */
+    uint64_t publishIfChanged();
+    
+    /**
+     * Latest published dashboard - O(1), never blocks and never walks live
+     * structures, so it is safe from any thread at any time
+     * 
+     * @return DashboardSnapshot - Shared read-only view; invalid until the first publish
+     */
+    DashboardSnapshot getPublishedDashboard() const;
+    
     /**
      * Get utilization rate for a specific zone
      * 
@@ -169,6 +384,15 @@ public:
      */
     double getZoneUtilization(int zoneID) const;
     
+    /**
+     * Copy-on-write copy of the current slot availability for what-if runs
+     * ("close zone 2", "300 more arrivals"); simulating on it never changes
+     * or blocks the live system
+     * 
+     * @return AllocationSnapshot - Independent snapshot; copy it to branch scenarios
+     */
+    AllocationSnapshot createSnapshot();
+    
     /**
      * Display comprehensive zone analytics
      */
@@ -198,8 +422,8 @@ public:
     AllocationEngine* getEngine() const;
     RollbackManager* getRollbackManager() const;
     Zone* getZoneByID(int zoneID) const;
-    DoublyLinkedList<ParkingRequest*>& getMasterHistory();
-    DoublyLinkedList<ParkingRequest*>& getActiveRequests();
+    SlotMap<ParkingRequest*>& getMasterHistory();
+    IntrusiveList<ParkingRequest>& getActiveRequests();
 };
 
 #endif // PARKINGSYSTEM_H
@@ -0,0 +1,122 @@
+#ifndef RESERVATIONBOOK_H
+#define RESERVATIONBOOK_H
+
+#include <ctime>
+#include <functional>
+#include <map>
+#include <queue>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Common.h"
+
+// Forward declarations
+class ParkingSlot;
+class Zone;
+
+// ============================================================================
+// RESERVATION STRUCT
+// ============================================================================
+struct Reservation {
+    int reservationID;
+    std::string vehicleID;
+    int slotIndex;       // Index into the book's slot table
+    time_t start;        // Window is [start, end)
+    time_t end;
+    bool held;           // Slot is currently claimed for this reservation
+    ParkingSlot* heldSlot;
+
+    Reservation() : reservationID(-1), slotIndex(-1), start(0), end(0), held(false), heldSlot(nullptr) {}
+};
+
+// ============================================================================
+// RESERVATION BOOK CLASS (Advance bookings for one zone)
+// ============================================================================
+// Each slot keeps a calendar of non-overlapping [start, end) windows in a
+// std::map keyed by start time, so a conflict check is one O(log R) lookup.
+// Per size class, slots are also ordered by the end of their last booking,
+// which finds a slot free for a window appended after existing bookings in
+// O(log S). A window that starts before some booking on every slot of its
+// size falls back to checking calendars one slot at a time, O(S log R) in
+// the worst case; it only runs for bookings made out of time order.
+// When a window starts, activateDue() claims the slot so walk-in traffic
+// cannot take it, and claimHeldSlot() hands it to the arriving vehicle.
+class ReservationBook {
+private:
+    typedef std::map<time_t, std::pair<time_t, int>> Calendar;   // start -> (end, reservationID)
+    typedef std::pair<time_t, int> TimedEntry;                    // (time, reservationID or slotIndex)
+
+    Zone* zone;
+    std::vector<ParkingSlot*> slots;                  // Book slot index -> slot
+    std::vector<Calendar> calendars;                  // Per slot
+    std::vector<time_t> lastEnd;                      // End of the latest booking per slot (0 = none)
+    std::set<TimedEntry> slotsByLastEnd[SLOT_SIZE_COUNT];
+    std::unordered_map<int, Reservation> reservations;
+    std::unordered_map<std::string, int> heldByVehicle;   // vehicleID -> held reservation
+    std::priority_queue<TimedEntry, std::vector<TimedEntry>, std::greater<TimedEntry>> startQueue;
+    std::priority_queue<TimedEntry, std::vector<TimedEntry>, std::greater<TimedEntry>> endQueue;
+    int nextReservationID;
+
+    void syncSlots();   // Pick up slots added to the zone since the last call
+    bool isSlotFree(int slotIndex, time_t start, time_t end) const;
+    int findFreeSlotIndex(time_t start, time_t end, SlotSize size);   // -1 if none; O(log S) or the O(S log R) fallback
+    void setLastEnd(int slotIndex, time_t end);
+    void releaseHold(Reservation& reservation);
+    void erase(int reservationID);
+
+public:
+    // Constructor
+    explicit ReservationBook(Zone* owner);
+
+    // ========================================================================
+    // BOOKING OPERATIONS
+    // ========================================================================
+
+    /**
+     * Book a slot of the given size for [start, end)
+     *
+     * @return int - Reservation ID, or -1 if no slot of that size is free for the window
+     */
+    int reserve(const std::string& vehicleID, time_t start, time_t end, SlotSize size);
+    bool cancel(int reservationID);
+
+    /**
+     * Slot of the given size free for the whole window, or nullptr
+     * O(log S) when the window starts after the slot's existing bookings
+     */
+    ParkingSlot* findFreeSlot(time_t start, time_t end, SlotSize size);
+
+    // ========================================================================
+    // ACTIVATION
+    // ========================================================================
+
+    /**
+     * Claim slots for windows that have started and release holds whose
+     * window ended without the vehicle arriving - O(log R) per event
+     *
+     * @param heldVehicles - Receives each vehicle that now has a held slot
+     * @param releasedVehicles - Receives each vehicle whose hold was given back
+     */
+    void activateDue(time_t now, std::vector<std::string>& heldVehicles,
+                     std::vector<std::string>& releasedVehicles);
+
+    // Earliest pending start or end time (maximum time_t if none) - O(1)
+    time_t getNextEventTime() const;
+
+    /**
+     * Hand over the slot held for this vehicle (nullptr if none); the
+     * reservation is consumed and the slot stays allocated
+     */
+    ParkingSlot* claimHeldSlot(const std::string& vehicleID);
+
+    // ========================================================================
+    // GETTERS
+    // ========================================================================
+    const Reservation* getReservation(int reservationID) const;
+    int getReservationCount() const;
+    bool hasHeldSlot(const std::string& vehicleID) const;
+};
+
+#endif // RESERVATIONBOOK_H
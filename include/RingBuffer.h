@@ -0,0 +1,154 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <memory>
+#include <new>
+#include <utility>
+
+// ============================================================================
+// RING BUFFER TEMPLATE CLASS (Fixed capacity, newest-first access)
+// ============================================================================
+// Contiguous circular array. push() is O(1) and silently discards the oldest
+// element once the buffer is full, so memory use never grows past capacity.
+// Elements are addressed from the newest end, which is what rollback needs.
+// Slots are raw aligned storage: only the size newest slots hold live
+// elements, and emplace() constructs straight into the next slot.
+template <typename T>
+class RingBuffer {
+private:
+    struct alignas(T) Storage {
+        unsigned char bytes[sizeof(T)];
+    };
+
+    std::unique_ptr<Storage[]> items;
+    int capacity;
+    int head;    // Index of the next write position
+    int size;
+    long long discarded;   // Elements dropped because the buffer was full
+
+    T* at(int index) {
+        return std::launder(reinterpret_cast<T*>(items[index].bytes));
+    }
+
+    const T* at(int index) const {
+        return std::launder(reinterpret_cast<const T*>(items[index].bytes));
+    }
+
+    // When full, the next write position holds the oldest element: drop it
+    void makeRoom() {
+        if (size == capacity) {
+            at(head)->~T();
+            size--;
+            discarded++;
+        }
+    }
+
+    void advance() {
+        head = (head + 1) % capacity;
+        size++;
+    }
+
+public:
+    // Constructor
+    explicit RingBuffer(int cap) : items(new Storage[cap > 0 ? cap : 1]), capacity(cap > 0 ? cap : 1),
+                                   head(0), size(0), discarded(0) {}
+
+    // Destructor
+    ~RingBuffer() {
+        clear();
+    }
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    // ========================================================================
+    // BUFFER OPERATIONS
+    // ========================================================================
+
+    // Push element, overwriting the oldest one if full
+    void push(const T& value) {
+        emplace(value);
+    }
+
+    void push(T&& value) {
+        emplace(std::move(value));
+    }
+
+    // Construct the element from args in place in the next buffer slot
+    // (placement new; the oldest element is destroyed first if full)
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+        makeRoom();
+        T* element = new (items[head].bytes) T(std::forward<Args>(args)...);
+        advance();
+        return *element;
+    }
+
+    // Remove newest element
+    void pop() {
+        if (size == 0) throw "Ring buffer underflow: cannot pop from empty buffer";
+        head = (head + capacity - 1) % capacity;
+        at(head)->~T();
+        size--;
+    }
+
+    // Get newest element
+    T& peek() {
+        if (size == 0) throw "Ring buffer is empty";
+        return *at((head + capacity - 1) % capacity);
+    }
+
+    const T& peek() const {
+        if (size == 0) throw "Ring buffer is empty";
+        return *at((head + capacity - 1) % capacity);
+    }
+
+    // Get element by age: 0 = newest, size-1 = oldest
+    T& fromNewest(int age) {
+        if (age < 0 || age >= size) throw "Index out of bounds";
+        return *at((head + capacity - 1 - age) % capacity);
+    }
+
+    const T& fromNewest(int age) const {
+        if (age < 0 || age >= size) throw "Index out of bounds";
+        return *at((head + capacity - 1 - age) % capacity);
+    }
+
+    // Drop the newest count elements at once
+    void popMany(int count) {
+        if (count < 0 || count > size) throw "Ring buffer underflow: cannot pop from empty buffer";
+        for (int i = 0; i < count; i++) {
+            pop();
+        }
+    }
+
+    void clear() {
+        popMany(size);
+        head = 0;
+    }
+
+    // ========================================================================
+    // GETTERS
+    // ========================================================================
+    int getSize() const {
+        return size;
+    }
+
+    int getCapacity() const {
+        return capacity;
+    }
+
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    bool isFull() const {
+        return size == capacity;
+    }
+
+    long long getDiscardedCount() const {
+        return discarded;
+    }
+};
+
+#endif // RINGBUFFER_H
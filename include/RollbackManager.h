@@ -1,7 +1,8 @@
 #ifndef ROLLBACKMANAGER_H
 #define ROLLBACKMANAGER_H
 
-#include "Stack.h"
+#include <vector>
+#include "RingBuffer.h"
 #include "Common.h"
 #include "ParkingRequest.h"
 #include "ParkingSlot.h"
@@ -10,13 +11,24 @@
 // ROLLBACK MANAGER CLASS
 // ============================================================================
 class RollbackManager {
+public:
+    // Number of commands kept for rollback; older ones are discarded
+    static const int DEFAULT_HISTORY_DEPTH = 4096;
+
 private:
-    Stack<Command> commandHistory;
+    RingBuffer<Command> commandHistory;  // Fixed-size, memory stays flat over uptime
     int totalRollbacksPerformed;
+    int currentGroupID;                  // Group stamped on new commands (0 = none)
+    int lastGroupID;
+    int truncatedGroupID;                // Group that lost its oldest commands to the ring (0 = none)
+    
+    void noteEviction();                 // Call before a push that will drop the oldest command
+    int countCommandsInUnits(int units) const;   // Commands covered by the newest units, -1 if too few, -2 if truncated
+    int findSlotConflict(int commandCount) const;   // First command whose old slot is taken, -1 if none
 
 public:
     // Constructor
-    RollbackManager();
+    RollbackManager(int historyDepth = DEFAULT_HISTORY_DEPTH);
     
     // Destructor
     ~RollbackManager();
@@ -32,6 +44,19 @@ public:
      */
     void recordCommand(const Command& command);
     
+    /**
+     * Record a command built in place from its fields
+     */
+    void recordCommand(ParkingRequest* request, ParkingSlot* slot, Zone* zone,
+                       RequestState oldState, RequestState newState);
+    
+    /**
+     * Group every command recorded until endGroup() into one rollback unit
+     * (used by batch operations so one rollback step undoes the whole batch)
+     */
+    void beginGroup();
+    void endGroup();
+    
     // ========================================================================
     // ROLLBACK OPERATIONS
     // ========================================================================
@@ -40,21 +65,33 @@ public:
      * Perform rollback of last k operations
      * 
      * Algorithm:
-     * 1. Pop k items from the command history stack
-     * 2. For each popped item:
+     * 1. Walk the commands of the k newest units in the history buffer (newest
+     *    first); a unit is one command, or one whole group from beginGroup()
+     * 2. For each command:
      *    - Revert ParkingSlot availability (free the slot)
      *    - Reset ParkingRequest state to oldState
-     * 3. Track rollback count
+     * 3. Drop those commands from the buffer and track rollback count
+     * 
+     * Only the last getHistoryDepth() commands can be rolled back. A group
+     * whose oldest commands were already discarded is refused as a whole
+     * rather than undone in part, and so is a range that would put a
+     * released/cancelled request back on a slot another vehicle now holds.
      * 
      * @param k - Number of operations to rollback
-     * @return bool - Returns true if successful, false if stack has fewer than k items
+     * @param touchedRequests - Receives every request whose state was reverted
+     *        (newest first, possibly repeated), so the caller can re-link just those
+     * @return bool - Returns true if successful, false (nothing reverted) if history has
+     *         fewer than k units, the k-th unit is a group that no longer fits in the
+     *         history, or a slot to be re-taken is held by another vehicle
      */
-    bool performRollback(int k);
+    bool performRollback(int k, std::vector<ParkingRequest*>& touchedRequests);
     
     // ========================================================================
     // HISTORY MANAGEMENT
     // ========================================================================
     int getHistorySize() const;
+    int getHistoryDepth() const;
+    long long getDiscardedCommandCount() const;
     int getTotalRollbacksPerformed() const;
     bool hasHistory() const;
     void clearHistory();
@@ -0,0 +1,248 @@
+#ifndef SLOTBITMAP_H
+#define SLOTBITMAP_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// ============================================================================
+// BIT SCAN HELPERS
+// ============================================================================
+// Index of the lowest set bit. word must be non-zero.
+inline int countTrailingZeros64(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return (int)index;
+#else
+    int index = 0;
+    while ((word & 1) == 0) {
+        word >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+inline int popCount64(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    int count = 0;
+    while (word != 0) {
+        word &= word - 1;   // Clear lowest set bit
+        count++;
+    }
+    return count;
+#endif
+}
+
+// ============================================================================
+// SLOT BITMAP (One bit per slot, 1 = available)
+// ============================================================================
+// Packed availability flags scanned 64 slots per word. searchHint is the
+// lowest word that may still contain a set bit, so findFirstSet() skips the
+// full prefix of a busy area and still returns the lowest free index.
+class SlotBitmap {
+private:
+    std::vector<uint64_t> words;
+    int bitCount;
+    int searchHint;
+
+public:
+    static const int BITS_PER_WORD = 64;
+
+    SlotBitmap() : bitCount(0), searchHint(0) {}
+
+    SlotBitmap(std::vector<uint64_t> initialWords, int initialBitCount)
+        : words(std::move(initialWords)), bitCount(initialBitCount), searchHint(0) {}
+
+    // Append one bit (slots are only ever appended to an area)
+    void pushBack(bool value) {
+        if (bitCount % BITS_PER_WORD == 0) {
+            words.push_back(0);
+        }
+        int index = bitCount++;
+        if (value) set(index);
+    }
+
+    void set(int index) {
+        int word = index / BITS_PER_WORD;
+        words[word] |= (uint64_t)1 << (index % BITS_PER_WORD);
+        if (word < searchHint) searchHint = word;
+    }
+
+    void reset(int index) {
+        words[index / BITS_PER_WORD] &= ~((uint64_t)1 << (index % BITS_PER_WORD));
+    }
+
+    bool test(int index) const {
+        return (words[index / BITS_PER_WORD] >> (index % BITS_PER_WORD)) & 1;
+    }
+
+    // Lowest set bit, or -1 if none - O(size/64) worst case
+    int findFirstSet() {
+        int wordCount = (int)words.size();
+        for (int w = searchHint; w < wordCount; w++) {
+            if (words[w] != 0) {
+                searchHint = w;
+                return w * BITS_PER_WORD + countTrailingZeros64(words[w]);
+            }
+        }
+        searchHint = wordCount;
+        return -1;
+    }
+
+    // Lowest set bit, or -1, without moving the hint (safe on a shared bitmap)
+    int peekFirstSet() const {
+        int wordCount = (int)words.size();
+        for (int w = searchHint; w < wordCount; w++) {
+            if (words[w] != 0) {
+                return w * BITS_PER_WORD + countTrailingZeros64(words[w]);
+            }
+        }
+        return -1;
+    }
+
+    // Number of set bits - O(size/64)
+    int count() const {
+        int total = 0;
+        for (uint64_t word : words) {
+            total += popCount64(word);
+        }
+        return total;
+    }
+
+    int size() const {
+        return bitCount;
+    }
+};
+
+// ============================================================================
+// ATOMIC SLOT BITMAP (Live slot availability shared between threads)
+// ============================================================================
+// Same layout as SlotBitmap, but set/reset/test and the scans work on atomic
+// words, so claimers search it without a lock. A bit can lag its slot for a
+// moment (set while a claimer is mid-CAS, or clear just after a free); callers
+// treat a set bit as a candidate and move on when the slot's CAS fails.
+// searchHint is only a starting point: findFirstSet() wraps to the words
+// before it, so a stale hint never hides a free slot. Growth (pushBack) is a
+// setup-time operation and must not run concurrently with anything else.
+class AtomicSlotBitmap {
+private:
+    std::unique_ptr<std::atomic<uint64_t>[]> words;
+    int wordCapacity;
+    int wordCount;
+    int bitCount;
+    std::atomic<int> searchHint;
+
+    void lowerHint(int word) {
+        int hint = searchHint.load(std::memory_order_relaxed);
+        while (word < hint && !searchHint.compare_exchange_weak(hint, word, std::memory_order_relaxed)) {}
+    }
+
+    int scanWords(int from, int to) const {
+        for (int w = from; w < to; w++) {
+            uint64_t word = words[w].load(std::memory_order_acquire);
+            if (word != 0) {
+                return w * SlotBitmap::BITS_PER_WORD + countTrailingZeros64(word);
+            }
+        }
+        return -1;
+    }
+
+public:
+    AtomicSlotBitmap() : wordCapacity(0), wordCount(0), bitCount(0), searchHint(0) {}
+    AtomicSlotBitmap(const AtomicSlotBitmap&) = delete;
+    AtomicSlotBitmap& operator=(const AtomicSlotBitmap&) = delete;
+
+    // Append one bit (slots are only ever appended, before the area is shared)
+    void pushBack(bool value) {
+        if (bitCount % SlotBitmap::BITS_PER_WORD == 0) {
+            if (wordCount == wordCapacity) {
+                int newCapacity = wordCapacity == 0 ? 4 : wordCapacity * 2;
+                std::unique_ptr<std::atomic<uint64_t>[]> grown(new std::atomic<uint64_t>[newCapacity]);
+                for (int w = 0; w < newCapacity; w++) {
+                    grown[w].store(w < wordCount ? words[w].load() : 0, std::memory_order_relaxed);
+                }
+                words = std::move(grown);
+                wordCapacity = newCapacity;
+            }
+            wordCount++;
+        }
+        int index = bitCount++;
+        if (value) set(index);
+    }
+
+    void set(int index) {
+        int word = index / SlotBitmap::BITS_PER_WORD;
+        words[word].fetch_or((uint64_t)1 << (index % SlotBitmap::BITS_PER_WORD));
+        lowerHint(word);
+    }
+
+    void reset(int index) {
+        words[index / SlotBitmap::BITS_PER_WORD].fetch_and(~((uint64_t)1 << (index % SlotBitmap::BITS_PER_WORD)));
+    }
+
+    bool test(int index) const {
+        return (words[index / SlotBitmap::BITS_PER_WORD].load()
+                >> (index % SlotBitmap::BITS_PER_WORD)) & 1;
+    }
+
+    // A set bit, or -1 if none. The lowest one when no other thread is writing.
+    int findFirstSet() {
+        int hint = searchHint.load(std::memory_order_relaxed);
+        if (hint > wordCount) hint = wordCount;
+        int index = scanWords(hint, wordCount);
+        if (index != -1) {
+            int word = index / SlotBitmap::BITS_PER_WORD;
+            if (word > hint) {
+                searchHint.compare_exchange_strong(hint, word, std::memory_order_relaxed);   // Lost race: keep the lower hint
+            }
+            return index;
+        }
+        return scanWords(0, hint);
+    }
+
+    // Lowest set bit at or after from, or -1 - moves on past a lost claim
+    int findNextSet(int from) const {
+        if (from >= bitCount) return -1;
+        int w = from / SlotBitmap::BITS_PER_WORD;
+        uint64_t word = words[w].load(std::memory_order_acquire) & (~(uint64_t)0 << (from % SlotBitmap::BITS_PER_WORD));
+        if (word != 0) {
+            return w * SlotBitmap::BITS_PER_WORD + countTrailingZeros64(word);
+        }
+        return scanWords(w + 1, wordCount);
+    }
+
+    int count() const {
+        int total = 0;
+        for (int w = 0; w < wordCount; w++) {
+            total += popCount64(words[w].load(std::memory_order_relaxed));
+        }
+        return total;
+    }
+
+    int size() const {
+        return bitCount;
+    }
+
+    // Plain copy of the current bits (e.g. for what-if snapshots)
+    SlotBitmap toSlotBitmap() const {
+        std::vector<uint64_t> copy(wordCount);
+        for (int w = 0; w < wordCount; w++) {
+            copy[w] = words[w].load(std::memory_order_acquire);
+        }
+        return SlotBitmap(std::move(copy), bitCount);
+    }
+};
+
+#endif // SLOTBITMAP_H
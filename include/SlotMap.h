@@ -0,0 +1,503 @@
+#ifndef SLOTMAP_H
+#define SLOTMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Node.h"
+
+// ============================================================================
+// SLOT MAP HANDLE
+// ============================================================================
+// Index + generation pair. A handle stays valid until its element is erased;
+// after that the generation no longer matches and lookups return nullptr.
+struct SlotMapHandle {
+    uint32_t index;
+    uint32_t generation;
+
+    SlotMapHandle() : index(0xFFFFFFFFu), generation(0) {}
+    SlotMapHandle(uint32_t i, uint32_t g) : index(i), generation(g) {}
+
+    bool isValid() const { return index != 0xFFFFFFFFu; }
+
+    bool operator==(const SlotMapHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const SlotMapHandle& other) const { return !(*this == other); }
+};
+
+// ============================================================================
+// SLOT MAP TEMPLATE CLASS (Chunked storage with stable handles)
+// ============================================================================
+// Drop-in replacement for DoublyLinkedList<T> on hot paths. Nodes are placed
+// in fixed-size chunks that are never reallocated, so Node<T>* pointers and
+// handles stay stable while neighbouring elements share cache lines. Nodes
+// are still linked in insertion order, which keeps the getHead()/next
+// traversal used throughout the core working unchanged.
+// begin()/end() do not follow those links: they sweep the chunks densely in
+// slot order and skip free slots, so a scan streams through memory instead
+// of chasing pointers. Slot order is insertion order as long as nothing was
+// erased or inserted at the front; use getHead()/next for list order.
+template <typename T, int ChunkSize = 256>
+class SlotMap {
+private:
+    struct Slot {
+        // Node storage must stay the first member so a Node<T>* can be
+        // mapped back to its slot without a search.
+        alignas(Node<T>) unsigned char storage[sizeof(Node<T>)];
+        uint32_t index;
+        uint32_t generation;
+        uint32_t nextFree;
+        bool occupied;
+
+        Node<T>* node() { return reinterpret_cast<Node<T>*>(storage); }
+    };
+
+    static const uint32_t NO_FREE_SLOT = 0xFFFFFFFFu;
+
+    std::vector<Slot*> chunks;
+    uint32_t slotCount;     // Slots handed out so far (occupied or free)
+    uint32_t freeHead;      // Head of the free-slot list
+    Node<T>* head;
+    Node<T>* tail;
+    int size;
+
+    Slot* slotAt(uint32_t index) const {
+        return &chunks[index / ChunkSize][index % ChunkSize];
+    }
+
+    static Slot* slotOf(Node<T>* node) {
+        return reinterpret_cast<Slot*>(node);
+    }
+
+    // Take a slot from the free list, or append a new one (allocating a
+    // fresh chunk only every ChunkSize insertions)
+    Slot* acquireSlot() {
+        if (freeHead != NO_FREE_SLOT) {
+            Slot* slot = slotAt(freeHead);
+            freeHead = slot->nextFree;
+            return slot;
+        }
+
+        if (slotCount % ChunkSize == 0) {
+            Slot* chunk = new Slot[ChunkSize];
+            for (int i = 0; i < ChunkSize; i++) {
+                chunk[i].index = slotCount + i;
+                chunk[i].generation = 0;
+                chunk[i].nextFree = NO_FREE_SLOT;
+                chunk[i].occupied = false;
+            }
+            chunks.push_back(chunk);
+        }
+        return slotAt(slotCount++);
+    }
+
+    void releaseSlot(Slot* slot) {
+        slot->node()->~Node<T>();
+        slot->occupied = false;
+        slot->generation++;
+        slot->nextFree = freeHead;
+        freeHead = slot->index;
+    }
+
+    // Construct a node in a free slot, forwarding args to Node<T>
+    template <typename... Args>
+    Node<T>* createNode(Slot*& slotOut, Args&&... args) {
+        slotOut = acquireSlot();
+        Node<T>* newNode = new (slotOut->storage) Node<T>(std::forward<Args>(args)...);
+        slotOut->occupied = true;
+        return newNode;
+    }
+
+    SlotMapHandle linkBack(Node<T>* newNode, Slot* slot) {
+        if (tail == nullptr) {
+            head = tail = newNode;
+        } else {
+            tail->next = newNode;
+            newNode->prev = tail;
+            tail = newNode;
+        }
+        size++;
+        return SlotMapHandle(slot->index, slot->generation);
+    }
+
+    SlotMapHandle linkFront(Node<T>* newNode, Slot* slot) {
+        if (head == nullptr) {
+            head = tail = newNode;
+        } else {
+            newNode->next = head;
+            head->prev = newNode;
+            head = newNode;
+        }
+        size++;
+        return SlotMapHandle(slot->index, slot->generation);
+    }
+
+public:
+    // Constructor
+    SlotMap() : slotCount(0), freeHead(NO_FREE_SLOT), head(nullptr), tail(nullptr), size(0) {}
+
+    SlotMap(const SlotMap& other)
+        : slotCount(0), freeHead(NO_FREE_SLOT), head(nullptr), tail(nullptr), size(0) {
+        Node<T>* current = other.head;
+        while (current != nullptr) {
+            insertBack(current->data);
+            current = current->next;
+        }
+    }
+
+    SlotMap& operator=(const SlotMap& other) {
+        if (this != &other) {
+            clear();
+            Node<T>* current = other.head;
+            while (current != nullptr) {
+                insertBack(current->data);
+                current = current->next;
+            }
+        }
+        return *this;
+    }
+
+    SlotMap(SlotMap&& other) noexcept
+        : chunks(std::move(other.chunks)), slotCount(other.slotCount), freeHead(other.freeHead),
+          head(other.head), tail(other.tail), size(other.size) {
+        other.chunks.clear();
+        other.slotCount = 0;
+        other.freeHead = NO_FREE_SLOT;
+        other.head = nullptr;
+        other.tail = nullptr;
+        other.size = 0;
+    }
+
+    SlotMap& operator=(SlotMap&& other) noexcept {
+        if (this != &other) {
+            releaseChunks();
+            chunks = std::move(other.chunks);
+            slotCount = other.slotCount;
+            freeHead = other.freeHead;
+            head = other.head;
+            tail = other.tail;
+            size = other.size;
+            other.chunks.clear();
+            other.slotCount = 0;
+            other.freeHead = NO_FREE_SLOT;
+            other.head = nullptr;
+            other.tail = nullptr;
+            other.size = 0;
+        }
+        return *this;
+    }
+
+    // Destructor
+    ~SlotMap() {
+        releaseChunks();
+    }
+
+    // ========================================================================
+    // BASIC OPERATIONS
+    // ========================================================================
+
+    // Insert at the end, returns a handle for O(1) erase/lookup
+    SlotMapHandle insertBack(const T& value) {
+        Slot* slot = nullptr;
+        Node<T>* newNode = createNode(slot, value);
+        return linkBack(newNode, slot);
+    }
+
+    SlotMapHandle insertBack(T&& value) {
+        Slot* slot = nullptr;
+        Node<T>* newNode = createNode(slot, std::move(value));
+        return linkBack(newNode, slot);
+    }
+
+    // Construct element in place at the end
+    template <typename... Args>
+    SlotMapHandle emplaceBack(Args&&... args) {
+        Slot* slot = nullptr;
+        Node<T>* newNode = createNode(slot, std::in_place, std::forward<Args>(args)...);
+        return linkBack(newNode, slot);
+    }
+
+    // Insert at the beginning, returns a handle for O(1) erase/lookup
+    SlotMapHandle insertFront(const T& value) {
+        Slot* slot = nullptr;
+        Node<T>* newNode = createNode(slot, value);
+        return linkFront(newNode, slot);
+    }
+
+    SlotMapHandle insertFront(T&& value) {
+        Slot* slot = nullptr;
+        Node<T>* newNode = createNode(slot, std::move(value));
+        return linkFront(newNode, slot);
+    }
+
+    // Construct element in place at the beginning
+    template <typename... Args>
+    SlotMapHandle emplaceFront(Args&&... args) {
+        Slot* slot = nullptr;
+        Node<T>* newNode = createNode(slot, std::in_place, std::forward<Args>(args)...);
+        return linkFront(newNode, slot);
+    }
+
+    // Remove from the beginning
+    void removeFront() {
+        removeNode(head);
+    }
+
+    // Remove from the end
+    void removeBack() {
+        removeNode(tail);
+    }
+
+    // Get front element
+    T& getFront() const {
+        if (head == nullptr) throw "List is empty";
+        return head->data;
+    }
+
+    // Get back element
+    T& getBack() const {
+        if (tail == nullptr) throw "List is empty";
+        return tail->data;
+    }
+
+    // ========================================================================
+    // HANDLE OPERATIONS
+    // ========================================================================
+
+    // Get element by handle, nullptr if the handle is stale
+    T* get(SlotMapHandle handle) const {
+        Node<T>* node = getNode(handle);
+        return node != nullptr ? &node->data : nullptr;
+    }
+
+    // Get node by handle, nullptr if the handle is stale
+    Node<T>* getNode(SlotMapHandle handle) const {
+        if (!handle.isValid() || handle.index >= slotCount) return nullptr;
+        Slot* slot = slotAt(handle.index);
+        if (!slot->occupied || slot->generation != handle.generation) return nullptr;
+        return slot->node();
+    }
+
+    // Handle of a node owned by this container
+    SlotMapHandle handleOf(Node<T>* node) const {
+        if (node == nullptr) return SlotMapHandle();
+        Slot* slot = slotOf(node);
+        return SlotMapHandle(slot->index, slot->generation);
+    }
+
+    bool contains(SlotMapHandle handle) const {
+        return getNode(handle) != nullptr;
+    }
+
+    // Erase by handle in O(1); returns false for stale handles
+    bool erase(SlotMapHandle handle) {
+        Node<T>* node = getNode(handle);
+        if (node == nullptr) return false;
+        removeNode(node);
+        return true;
+    }
+
+    // ========================================================================
+    // SEARCH AND ACCESS OPERATIONS
+    // ========================================================================
+
+    // Find element by value (requires operator== for type T)
+    Node<T>* find(const T& value) const {
+        Node<T>* current = head;
+        while (current != nullptr) {
+            if (current->data == value) {
+                return current;
+            }
+            current = current->next;
+        }
+        return nullptr;
+    }
+
+    // Get element at position in traversal order
+    T& getAt(int index) const {
+        if (index < 0 || index >= size) throw "Index out of bounds";
+
+        Node<T>* current = head;
+        for (int i = 0; i < index; i++) {
+            current = current->next;
+        }
+        return current->data;
+    }
+
+    // ========================================================================
+    // UTILITY OPERATIONS
+    // ========================================================================
+
+    int getSize() const {
+        return size;
+    }
+
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    // Slots handed out so far; indices [0, getSlotCount()) cover every element
+    uint32_t getSlotCount() const {
+        return slotCount;
+    }
+
+    // Visit the elements stored in slots [begin, end), in slot order rather
+    // than list order. Read-only, so disjoint ranges can be walked by
+    // different threads at once (e.g. chunked analytics)
+    template <typename Func>
+    void forEachInSlotRange(uint32_t begin, uint32_t end, Func func) const {
+        if (end > slotCount) end = slotCount;
+        for (uint32_t i = begin; i < end; i++) {
+            Slot* slot = slotAt(i);
+            if (slot->occupied) func(slot->node()->data);
+        }
+    }
+
+    // Clear all elements (chunks are kept for reuse)
+    void clear() {
+        while (head != nullptr) {
+            removeNode(head);
+        }
+    }
+
+    // Remove a specific node in O(1)
+    void removeNode(Node<T>* node) {
+        if (node == nullptr) return;
+
+        if (node->prev != nullptr) {
+            node->prev->next = node->next;
+        } else {
+            head = node->next;
+        }
+
+        if (node->next != nullptr) {
+            node->next->prev = node->prev;
+        } else {
+            tail = node->prev;
+        }
+
+        releaseSlot(slotOf(node));
+        size--;
+    }
+
+    // ========================================================================
+    // ITERATION SUPPORT
+    // ========================================================================
+
+    Node<T>* getHead() const {
+        return head;
+    }
+
+    Node<T>* getTail() const {
+        return tail;
+    }
+
+    // ========================================================================
+    // DENSE SLOT ITERATOR (Forward, slot order, skips free slots)
+    // ========================================================================
+    template <bool IsConst>
+    class SlotIterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<IsConst, const T*, T*>::type pointer;
+        typedef typename std::conditional<IsConst, const T&, T&>::type reference;
+
+    private:
+        const SlotMap* map;
+        Slot* current;      // nullptr once past the last slot (end)
+        Slot* chunkEnd;     // One past the last handed-out slot of current's chunk
+        uint32_t chunk;
+
+        // Point at the first slot of chunk c, or become end()
+        void enterChunk(uint32_t c) {
+            chunk = c;
+            if ((size_t)c >= map->chunks.size() || (uint32_t)c * ChunkSize >= map->slotCount) {
+                current = nullptr;
+                chunkEnd = nullptr;
+                return;
+            }
+            uint32_t inChunk = map->slotCount - c * ChunkSize;
+            current = map->chunks[c];
+            chunkEnd = current + (inChunk < (uint32_t)ChunkSize ? inChunk : (uint32_t)ChunkSize);
+        }
+
+        void skipFree() {
+            while (current != nullptr && !current->occupied) {
+                if (++current == chunkEnd) enterChunk(chunk + 1);
+            }
+        }
+
+    public:
+        SlotIterator() : map(nullptr), current(nullptr), chunkEnd(nullptr), chunk(0) {}
+        SlotIterator(const SlotMap* owner, bool atEnd) : map(owner), current(nullptr), chunkEnd(nullptr), chunk(0) {
+            if (!atEnd) {
+                enterChunk(0);
+                skipFree();
+            }
+        }
+
+        // iterator -> const_iterator conversion
+        template <bool OtherConst, typename = typename std::enable_if<IsConst && !OtherConst>::type>
+        SlotIterator(const SlotIterator<OtherConst>& other)
+            : map(other.map), current(other.current), chunkEnd(other.chunkEnd), chunk(other.chunk) {}
+
+        reference operator*() const { return current->node()->data; }
+        pointer operator->() const { return &current->node()->data; }
+
+        SlotIterator& operator++() {
+            if (++current == chunkEnd) enterChunk(chunk + 1);
+            skipFree();
+            return *this;
+        }
+
+        SlotIterator operator++(int) {
+            SlotIterator previous = *this;
+            ++(*this);
+            return previous;
+        }
+
+        bool operator==(const SlotIterator& other) const { return current == other.current; }
+        bool operator!=(const SlotIterator& other) const { return current != other.current; }
+
+        // Underlying node, e.g. for removeNode()
+        Node<T>* getNode() const { return current != nullptr ? current->node() : nullptr; }
+
+        template <bool> friend class SlotIterator;
+    };
+
+    // STL-style iteration (range-for and <algorithm>).
+    // Unordered with respect to the list: begin()/end() visit elements in
+    // slot (storage) order, and getHead()/next visit them in list order.
+    // The two orders differ once an erase has freed a slot that a later
+    // insert reuses, or after insertFront()/emplaceFront(). Callers that
+    // need list order (e.g. newest/oldest first) must walk getHead()/next.
+    typedef SlotIterator<false> iterator;
+    typedef SlotIterator<true> const_iterator;
+
+    iterator begin() { return iterator(this, false); }
+    iterator end() { return iterator(this, true); }
+    const_iterator begin() const { return const_iterator(this, false); }
+    const_iterator end() const { return const_iterator(this, true); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+private:
+    void releaseChunks() {
+        clear();
+        for (Slot* chunk : chunks) {
+            delete[] chunk;
+        }
+        chunks.clear();
+        slotCount = 0;
+        freeHead = NO_FREE_SLOT;
+    }
+};
+
+#endif // SLOTMAP_H
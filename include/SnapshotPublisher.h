@@ -0,0 +1,165 @@
+#ifndef SNAPSHOTPUBLISHER_H
+#define SNAPSHOTPUBLISHER_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// SNAPSHOT PUBLISHER TEMPLATE CLASS (RCU-style publication of immutable values)
+// ============================================================================
+// A writer builds a complete T off to the side and publish() swaps it in
+// with one atomic pointer exchange; readers acquire() the current version
+// without ever blocking the writer or each other. Published values are
+// never modified, so a reader sees one consistent state for as long as it
+// keeps the handle.
+//
+// Reclamation is epoch based. acquire() pins the current epoch in a reader
+// slot, loads the pointer, takes a reference and unpins: a fixed number of
+// atomic operations, so readers are wait-free while fewer than
+// READER_SLOTS threads are inside acquire() at the same instant. A replaced
+// version is retired with the epoch it was replaced in, and the publisher's
+// reference is dropped once no slot is pinned at that epoch or earlier;
+// the last handle then frees it.
+template <typename T>
+class SnapshotPublisher {
+public:
+    static const int READER_SLOTS = 64;
+
+private:
+    struct Version {
+        T value;
+        uint64_t number;
+        std::atomic<int> references;   // Publisher (until retired) + live handles
+
+        Version(T&& v, uint64_t n) : value(std::move(v)), number(n), references(1) {}
+    };
+
+    static void release(Version* version) {
+        if (version != nullptr && version->references.fetch_sub(1) == 1) {
+            delete version;
+        }
+    }
+
+public:
+    // ========================================================================
+    // SNAPSHOT HANDLE (Shared, read-only reference to one published version)
+    // ========================================================================
+    class Handle {
+    private:
+        Version* version;
+
+        explicit Handle(Version* v) : version(v) {}   // Takes over a reference
+        friend class SnapshotPublisher;
+
+    public:
+        Handle() : version(nullptr) {}
+        Handle(const Handle& other) : version(other.version) {
+            if (version != nullptr) version->references.fetch_add(1);
+        }
+        Handle(Handle&& other) noexcept : version(other.version) {
+            other.version = nullptr;
+        }
+        Handle& operator=(Handle other) {   // Copy and swap
+            std::swap(version, other.version);
+            return *this;
+        }
+        ~Handle() {
+            release(version);
+        }
+
+        bool isValid() const { return version != nullptr; }   // false before the first publish
+        const T& operator*() const { return version->value; }
+        const T* operator->() const { return &version->value; }
+        uint64_t getVersion() const { return version != nullptr ? version->number : 0; }
+    };
+
+private:
+    static const uint64_t UNPINNED = 0;
+
+    std::atomic<Version*> current;
+    std::atomic<uint64_t> epoch;                   // Starts at 1; UNPINNED is never a real epoch
+    mutable std::atomic<uint64_t> readerEpochs[READER_SLOTS];   // Pinned epoch per slot (UNPINNED when free)
+    std::mutex writerMutex;                        // Serializes publish(); readers never take it
+    std::vector<std::pair<Version*, uint64_t>> retired;   // Replaced versions + retire epoch
+    uint64_t nextVersion;
+
+    // Drop the publisher's reference to every retired version no reader can still be loading
+    void reclaim() {
+        uint64_t oldestPinned = UINT64_MAX;
+        for (int s = 0; s < READER_SLOTS; s++) {
+            uint64_t pinned = readerEpochs[s].load();
+            if (pinned != UNPINNED && pinned < oldestPinned) oldestPinned = pinned;
+        }
+        size_t kept = 0;
+        for (size_t i = 0; i < retired.size(); i++) {
+            if (retired[i].second < oldestPinned) {
+                release(retired[i].first);
+            } else {
+                retired[kept++] = retired[i];
+            }
+        }
+        retired.resize(kept);
+    }
+
+public:
+    // Constructor (nothing published yet)
+    SnapshotPublisher() : current(nullptr), epoch(1), nextVersion(1) {
+        for (int s = 0; s < READER_SLOTS; s++) {
+            readerEpochs[s].store(UNPINNED);
+        }
+    }
+
+    // Destructor (handles still held by readers stay valid)
+    ~SnapshotPublisher() {
+        for (std::pair<Version*, uint64_t>& entry : retired) {
+            release(entry.first);
+        }
+        release(current.load());
+    }
+
+    SnapshotPublisher(const SnapshotPublisher&) = delete;
+    SnapshotPublisher& operator=(const SnapshotPublisher&) = delete;
+
+    // ========================================================================
+    // WRITER SIDE
+    // ========================================================================
+
+    // Make value the current version; returns its version number (1, 2, ...)
+    uint64_t publish(T value) {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        uint64_t number = nextVersion++;
+        Version* previous = current.exchange(new Version(std::move(value), number));
+        if (previous != nullptr) {
+            // Readers pinned at this epoch or earlier may still be loading previous
+            retired.push_back(std::make_pair(previous, epoch.fetch_add(1)));
+        }
+        reclaim();
+        return number;
+    }
+
+    // ========================================================================
+    // READER SIDE
+    // ========================================================================
+
+    // O(1), never blocks; invalid handle until something is published
+    Handle acquire() const {
+        size_t start = std::hash<std::thread::id>()(std::this_thread::get_id());
+        for (int attempt = 0;; attempt++) {
+            std::atomic<uint64_t>& slot = readerEpochs[(start + attempt) % READER_SLOTS];
+            uint64_t expected = UNPINNED;
+            if (!slot.compare_exchange_strong(expected, epoch.load())) continue;   // Slot busy: try the next
+
+            Version* version = current.load();
+            if (version != nullptr) version->references.fetch_add(1);
+            slot.store(UNPINNED);
+            return Handle(version);
+        }
+    }
+};
+
+#endif // SNAPSHOTPUBLISHER_H
@@ -2,19 +2,24 @@
 #define STACK_H
 
 #include "Node.h"
+#include "NodeIterator.h"
+#include "NodePool.h"
 
 // ============================================================================
 // STACK TEMPLATE CLASS (LIFO - Last In First Out)
 // ============================================================================
-template <typename T>
+// Allocator: HeapNodeAllocator<T> (default) or PooledNodeAllocator<T>
+template <typename T, typename Allocator = HeapNodeAllocator<T>>
 class Stack {
 private:
     Node<T>* top;
+    Node<T>* bottom;   // Oldest element, lets iterators walk back from end()
     int size;
+    Allocator allocator;
 
 public:
     // Constructor
-    Stack() : top(nullptr), size(0) {}
+    Stack() : top(nullptr), bottom(nullptr), size(0) {}
     
     // Destructor
     ~Stack() {
@@ -27,19 +32,46 @@ public:
     
     // Push element onto stack
     void push(const T& value) {
-        Node<T>* newNode = new Node<T>(value);
+        link(allocator.create(value));
+    }
+    
+    void push(T&& value) {
+        link(allocator.create(std::move(value)));
+    }
+    
+    // Construct element in place on top of the stack
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+        Node<T>* newNode = allocator.create(std::in_place, std::forward<Args>(args)...);
+        link(newNode);
+        return newNode->data;
+    }
+
+private:
+    void link(Node<T>* newNode) {
         newNode->next = top;
+        if (top != nullptr) {
+            top->prev = newNode;
+        } else {
+            bottom = newNode;
+        }
         top = newNode;
         size++;
     }
-    
+
+public:
     // Pop element from stack
     void pop() {
         if (top == nullptr) throw "Stack underflow: cannot pop from empty stack";
         
         Node<T>* temp = top;
         top = top->next;
-        delete temp;
+        if (top != nullptr) {
+            top->prev = nullptr;
+        } else {
+            bottom = nullptr;
+        }
+        allocator.destroy(temp);
         size--;
     }
     
@@ -79,6 +111,21 @@ public:
     int count() const {
         return size;
     }
+    
+    // ========================================================================
+    // ITERATION SUPPORT (top of stack first)
+    // ========================================================================
+
+    // STL-style iteration (range-for and <algorithm>)
+    typedef NodeIterator<T, false> iterator;
+    typedef NodeIterator<T, true> const_iterator;
+
+    iterator begin() { return iterator(top, bottom); }
+    iterator end() { return iterator(nullptr, bottom); }
+    const_iterator begin() const { return const_iterator(top, bottom); }
+    const_iterator end() const { return const_iterator(nullptr, bottom); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
 };
 
 #endif // STACK_H
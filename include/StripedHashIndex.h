@@ -0,0 +1,75 @@
+#ifndef STRIPEDHASHINDEX_H
+#define STRIPEDHASHINDEX_H
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include "HashIndex.h"
+
+// ============================================================================
+// STRIPED HASH INDEX TEMPLATE CLASS (HashIndex split under per-stripe locks)
+// ============================================================================
+// Keys are spread over STRIPE_COUNT independent HashIndex tables, each with
+// its own mutex, so threads working on different keys rarely share a lock.
+// The index does not lock by itself: when it is shared between threads the
+// caller holds mutexFor(key) around find/insert/erase of that key. That lets
+// a caller keep the stripe locked across a whole check-then-act sequence.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class StripedHashIndex {
+public:
+    static const int STRIPE_COUNT = 64;   // Power of two
+
+private:
+    struct Stripe {
+        std::mutex mutex;
+        HashIndex<Key, Value, Hash> index;
+    };
+
+    Stripe stripes[STRIPE_COUNT];
+    Hash hasher;
+
+    // Stripe from the high bits of a mixed hash; HashIndex buckets use the
+    // low bits, so keys sharing a stripe still spread over its buckets
+    Stripe& stripeFor(const Key& key) {
+        uint64_t mixed = static_cast<uint64_t>(hasher(key)) * 0x9E3779B97F4A7C15ull;
+        return stripes[mixed >> 58];
+    }
+
+public:
+    // ========================================================================
+    // LOCKING
+    // ========================================================================
+    std::mutex& mutexFor(const Key& key) {
+        return stripeFor(key).mutex;
+    }
+
+    // ========================================================================
+    // INDEX OPERATIONS (Caller holds mutexFor(key) when shared)
+    // ========================================================================
+    bool insert(const Key& key, const Value& value) {
+        return stripeFor(key).index.insert(key, value);
+    }
+
+    Value* find(const Key& key) {
+        return stripeFor(key).index.find(key);
+    }
+
+    bool erase(const Key& key) {
+        return stripeFor(key).index.erase(key);
+    }
+
+    // ========================================================================
+    // GETTERS
+    // ========================================================================
+
+    // Sum over stripes; exact only while no other thread is writing
+    int getSize() const {
+        int total = 0;
+        for (const Stripe& stripe : stripes) {
+            total += stripe.index.getSize();
+        }
+        return total;
+    }
+};
+
+#endif // STRIPEDHASHINDEX_H
@@ -2,6 +2,7 @@
 #define VEHICLE_H
 
 #include <string>
+#include "Common.h"
 
 // ============================================================================
 // VEHICLE CLASS
@@ -10,10 +11,11 @@ class Vehicle {
 private:
     std::string vehicleID;
     int preferredZoneID;
+    VehicleType type;
 
 public:
     // Constructor
-    Vehicle(const std::string& id, int zoneID);
+    Vehicle(std::string id, int zoneID, VehicleType vehicleType = VehicleType::SEDAN);
     
     // Destructor
     ~Vehicle();
@@ -21,8 +23,9 @@ public:
     // ========================================================================
     // GETTERS
     // ========================================================================
-    std::string getVehicleID() const;
+    const std::string& getVehicleID() const;
     int getPreferredZoneID() const;
+    VehicleType getType() const;
     
     // ========================================================================
     // SETTERS
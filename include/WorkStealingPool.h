@@ -0,0 +1,73 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Task body for parallelFor(); receives the task index
+typedef std::function<void(int)> IndexedTask;
+
+// ============================================================================
+// WORK STEALING POOL CLASS (Fork-join over task indices)
+// ============================================================================
+// Each worker, plus the calling thread, owns a deque of task indices. A
+// parallelFor() deals the indices out in contiguous blocks; a thread works
+// through its own block from the front and, once it runs dry, steals from
+// the back of the others, so uneven chunks still finish together. Every
+// deque has its own short-held mutex and no lock is shared by all threads
+// while tasks run. Tasks must not throw.
+class WorkStealingPool {
+private:
+    struct QueuedTask {
+        const IndexedTask* body;   // Owned by the parallelFor() call that queued it
+        int index;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<QueuedTask> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;   // One per worker, the last for the caller
+    std::vector<std::thread> workers;
+    std::mutex jobMutex;                   // One parallelFor() at a time
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;   // Workers wait here between jobs
+    std::condition_variable doneCondition;   // Caller waits here for the last task
+    unsigned long long jobGeneration;
+    bool stopping;
+    std::atomic<int> remainingTasks;
+
+    bool popOwn(int queueIndex, QueuedTask& out);
+    bool steal(int thiefIndex, QueuedTask& out);
+    void runTasks(int queueIndex);   // Until no queue has work
+    void workerLoop(int queueIndex);
+
+public:
+    // Constructor (threadCount = 0 runs every task on the caller)
+    explicit WorkStealingPool(int threadCount);
+
+    // Destructor (joins the workers)
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * Run task(0) .. task(taskCount - 1) across the workers and the calling
+     * thread, returning once all have finished. Tasks run in no particular
+     * order; write results by index and reduce them afterwards for a
+     * deterministic answer
+     */
+    void parallelFor(int taskCount, const IndexedTask& task);
+
+    int getThreadCount() const;   // Workers, not counting the caller
+};
+
+#endif // WORKSTEALINGPOOL_H
@@ -2,10 +2,31 @@
 #define ZONE_H
 
 #include "LinkedList.h"
+#include "SlotMap.h"
+#include "SlotBitmap.h"
+#include "FreeSlotStack.h"
+#include "Common.h"
+#include <atomic>
+#include <mutex>
+#include <vector>
 
 // Forward declarations
+class AllocationEngine;
 class ParkingArea;
 class ParkingSlot;
+class ReservationBook;
+class Zone;
+
+// ============================================================================
+// OVERFLOW CANDIDATE (Precomputed by AllocationEngine)
+// ============================================================================
+struct OverflowCandidate {
+    Zone* zone;
+    int hops;       // Adjacency distance from the owning zone (>= 1)
+    int position;   // zone's load index position, so full zones are skipped without touching them
+
+    OverflowCandidate(Zone* z, int h, int p) : zone(z), hops(h), position(p) {}
+};
 
 // ============================================================================
 // ZONE CLASS
@@ -13,9 +34,23 @@ class ParkingSlot;
 class Zone {
 private:
     int zoneID;
-    DoublyLinkedList<ParkingArea*> parkingAreas;
+    SlotMap<ParkingArea*> parkingAreas;
+    std::vector<ParkingArea*> areaDirectory;   // Area index -> area, for O(1) slot handle resolve
+    AtomicSlotBitmap areasWithFreeSlots;   // Bit per area index, set while the area has a free slot
+    AtomicSlotBitmap areasWithFreeSlotsBySize[SLOT_SIZE_COUNT];   // Same, per slot size class
+    std::vector<ParkingSlot*> slotDirectory;   // Zone slot index -> slot, for the free-slot stacks
+    FreeSlotStack freeSlotsBySize[SLOT_SIZE_COUNT];   // Free slots of each size, popped by claims
     DoublyLinkedList<Zone*> adjacentZones;
     int totalCapacity;
+    std::atomic<int> availableSlots;   // Maintained through the onSlot*() callbacks
+    std::atomic<int> availableBySize[SLOT_SIZE_COUNT];
+    AllocationEngine* facility;      // Receives the same deltas for facility-wide totals
+    int facilityPosition;            // This zone's position in the engine's load index
+    std::vector<OverflowCandidate> overflowOrder;   // Other zones, nearest first
+    ReservationBook* reservationBook;   // Created on first booking (nullptr until then)
+    std::mutex slotMutex;               // Guards the reservation book in thread-safe mode (see AllocationEngine::lockZone)
+
+    void registerSlot(ParkingSlot* slot);   // Gives the slot a zone slot index
 
 public:
     // Constructor
@@ -29,6 +64,7 @@ public:
     // ========================================================================
     void addParkingArea(ParkingArea* area);
     ParkingArea* findParkingAreaByID(int areaID);
+    ParkingArea* getAreaAt(int areaIndex) const;
     
     // ========================================================================
     // ADJACENCY/NEIGHBOR MANAGEMENT
@@ -37,10 +73,39 @@ public:
     void removeAdjacentZone(Zone* zone);
     DoublyLinkedList<Zone*>& getAdjacentZones();
     
+    // Reachable zones sorted by hop distance (rebuilt by AllocationEngine on change)
+    const std::vector<OverflowCandidate>& getOverflowOrder() const;
+    void setOverflowOrder(std::vector<OverflowCandidate> order);
+    
     // ========================================================================
     // SLOT SEARCH
     // ========================================================================
+    // claimAvailableSlot() pops the zone's free-slot stack for that size, so
+    // a claim is O(1) however full the zone is. An entry is only a candidate:
+    // a slot taken directly (a reservation hold, a rollback) stays on the
+    // stack until a claimer pops it, finds it occupied and drops it.
+    // The find*() peeks do not claim anything and stay bitmap scans for the
+    // lowest free slot, O(A/64 + S/64) words for A areas of S slots.
     ParkingSlot* findAvailableSlot();
+    ParkingSlot* findAvailableSlot(SlotSize size);
+    ParkingSlot* claimAvailableSlot(SlotSize size);   // Lock-free; safe against concurrent claimers
+    
+    // ========================================================================
+    // COUNTER UPDATES (called by ParkingArea when a slot changes state)
+    // ========================================================================
+    void onSlotAllocated(int areaIndex, SlotSize size);
+    void onSlotFreed(int areaIndex, SlotSize size);
+    void onSlotAdded(int areaIndex, ParkingSlot* slot);
+    void pushFreeSlot(ParkingSlot* slot);   // Called once a released slot is FREE again
+    void attachToFacility(AllocationEngine* engine, int position);
+    int getFacilityPosition() const;
+    
+    // ========================================================================
+    // RESERVATIONS
+    // ========================================================================
+    ReservationBook* getReservationBook();   // Creates the book on first use
+    bool hasReservationBook() const;
+    std::mutex& getSlotMutex();
     
     // ========================================================================
     // GETTERS
@@ -48,13 +113,14 @@ public:
     int getZoneID() const;
     int getTotalCapacity() const;
     int getAvailableSlots() const;
-    DoublyLinkedList<ParkingArea*>& getParkingAreas();
+    int getAvailableSlots(SlotSize size) const;
+    SlotMap<ParkingArea*>& getParkingAreas();
     
     // ========================================================================
     // UTILITY METHODS
     // ========================================================================
     void displayInfo() const;
-    void refreshCapacity();
+    void refreshCapacity();   // Full recount; counters are normally kept in sync incrementally
 };
 
 #endif // ZONE_H
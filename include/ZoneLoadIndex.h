@@ -0,0 +1,51 @@
+#ifndef ZONELOADINDEX_H
+#define ZONELOADINDEX_H
+
+#include <atomic>
+#include <memory>
+
+// ============================================================================
+// ZONE LOAD INDEX CLASS (Max segment tree over zone free-slot counts)
+// ============================================================================
+// Each zone owns one leaf, addressed by the position returned from add().
+// Internal nodes hold the position of the leaf with the most free slots in
+// their range (lowest position wins ties), so updates and queries are
+// O(log Z).
+// Writers (add/update) must be serialized by the caller. Every cell is an
+// atomic, so queries may run alongside an update without a lock; such a
+// query can see a half-applied update and return a slightly stale answer,
+// which callers treat as a hint (the slot claim itself decides). add() may
+// reallocate and must not overlap queries.
+class ZoneLoadIndex {
+private:
+    std::unique_ptr<std::atomic<int>[]> available;   // Leaf values, indexed by position
+    std::unique_ptr<std::atomic<int>[]> tree;        // tree[1] is the root; leaves start at leafBase
+    int size;                     // Positions in use
+    int leafBase;                 // Power of two >= number of positions (also the capacity of available)
+
+    int better(int a, int b) const;   // Position with more free slots (-1 = none)
+    void rebuild(int newLeafBase);
+
+public:
+    // Constructor
+    ZoneLoadIndex();
+
+    ZoneLoadIndex(const ZoneLoadIndex&) = delete;
+    ZoneLoadIndex& operator=(const ZoneLoadIndex&) = delete;
+
+    // ========================================================================
+    // INDEX OPERATIONS
+    // ========================================================================
+    int add(int availableSlots);                    // Returns the new zone's position
+    void update(int position, int availableSlots);  // O(log Z)
+
+    // ========================================================================
+    // QUERIES (Lock-free)
+    // ========================================================================
+    int mostAvailable() const;     // Position with the most free slots, -1 if empty - O(1)
+    int firstNonFull() const;      // Lowest position with a free slot, -1 if none - O(log Z)
+    int getAvailableAt(int position) const;
+    int getSize() const;
+};
+
+#endif // ZONELOADINDEX_H
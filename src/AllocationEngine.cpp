@@ -1,98 +1,361 @@
 #include "AllocationEngine.h"
+#include "AllocationPolicies.h"
 #include "ParkingArea.h"
+#include <algorithm>
 #include <iostream>
 
-AllocationEngine::AllocationEngine() {}
+AllocationEngine::AllocationEngine()
+    : facilityCapacity(0), facilityAvailableSlots(0), overflowOrdersDirty(false), verbose(true),
+      policyType(AllocationPolicyType::NEAREST_ADJACENT), threadSafe(false) {
+    for (int s = 0; s < SLOT_SIZE_COUNT; s++) {
+        facilityAvailableBySize[s] = 0;
+    }
+}
 
 AllocationEngine::~AllocationEngine() {}
 
-Zone* AllocationEngine::findZoneByID(int zoneID) {
-    Node<Zone*>* current = allZones.getHead();
-    while (current != nullptr) {
-        if (current->data != nullptr && current->data->getZoneID() == zoneID) {
-            return current->data;
+Zone* AllocationEngine::findZoneByID(int zoneID) const {
+    if (zoneID >= 0 && zoneID < DENSE_ZONE_ID_LIMIT) {
+        return zoneID < (int)denseZoneTable.size() ? denseZoneTable[zoneID] : nullptr;
+    }
+    Zone* const* entry = sparseZoneTable.find(zoneID);
+    return entry != nullptr ? *entry : nullptr;
+}
+
+bool AllocationEngine::hasZone(int zoneID) const {
+    return findZoneByID(zoneID) != nullptr;
+}
+
+bool AllocationEngine::addZone(Zone* zone) {
+    if (zone == nullptr) {
+        return false;
+    }
+
+    int zoneID = zone->getZoneID();
+    if (hasZone(zoneID)) {
+        std::cerr << "❌ ERROR: Zone " << zoneID << " already exists!\n";
+        return false;
+    }
+
+    if (zoneID >= 0 && zoneID < DENSE_ZONE_ID_LIMIT) {
+        if (zoneID >= (int)denseZoneTable.size()) {
+            denseZoneTable.resize(zoneID + 1, nullptr);
+        }
+        denseZoneTable[zoneID] = zone;
+    } else {
+        sparseZoneTable.insert(zoneID, zone);
+    }
+    allZones.insertBack(zone);
+    int position;
+    {
+        std::unique_lock<std::mutex> indexLock(loadIndexMutex);   // add() may reallocate the trees
+        position = loadIndex.add(zone->getAvailableSlots());
+        zonesByPosition.push_back(zone);
+        nonFullZones.pushBack(zone->getAvailableSlots() > 0);
+        staleLoadPositions.pushBack(false);
+        for (int s = 0; s < SLOT_SIZE_COUNT; s++) {
+            int available = zone->getAvailableSlots(static_cast<SlotSize>(s));
+            loadIndexBySize[s].add(available);
+            nonFullZonesBySize[s].pushBack(available > 0);
+            staleLoadPositionsBySize[s].pushBack(false);
+            facilityAvailableBySize[s] += available;
         }
-        current = current->next;
     }
-    return nullptr;
+    zone->attachToFacility(this, position);
+    facilityCapacity += zone->getTotalCapacity();
+    facilityAvailableSlots += zone->getAvailableSlots();
+    overflowOrdersDirty = true;
+    return true;
 }
 
-void AllocationEngine::addZone(Zone* zone) {
-    if (zone != nullptr) {
-        allZones.insertBack(zone);
+bool AllocationEngine::connectZones(int zoneA, int zoneB) {
+    Zone* first = findZoneByID(zoneA);
+    Zone* second = findZoneByID(zoneB);
+    if (first == nullptr || second == nullptr || first == second) {
+        std::cerr << "❌ ERROR: Cannot connect Zone " << zoneA << " and Zone " << zoneB << "!\n";
+        return false;
+    }
+    for (Zone* neighbour : first->getAdjacentZones()) {
+        if (neighbour == second) return true;   // Already adjacent
+    }
+    first->addAdjacentZone(second);
+    second->addAdjacentZone(first);
+    return true;
+}
+
+void AllocationEngine::invalidateOverflowOrders() {
+    overflowOrdersDirty = true;
+}
+
+void AllocationEngine::rebuildOverflowOrders() {
+    // Number the zones so BFS can use flat distance arrays
+    std::vector<Zone*> zones(allZones.begin(), allZones.end());
+    HashIndex<Zone*, int> zoneIndex;
+    for (int i = 0; i < (int)zones.size(); i++) {
+        zoneIndex.insert(zones[i], i);
+    }
+
+    std::vector<int> hops(zones.size());
+    std::vector<int> queue;
+    queue.reserve(zones.size());
+    for (int source = 0; source < (int)zones.size(); source++) {
+        std::fill(hops.begin(), hops.end(), -1);
+        queue.clear();
+        hops[source] = 0;
+        queue.push_back(source);
+
+        // BFS visits zones in non-decreasing hop order, so the queue is
+        // already the overflow order
+        for (int head = 0; head < (int)queue.size(); head++) {
+            int current = queue[head];
+            for (Zone* neighbour : zones[current]->getAdjacentZones()) {
+                const int* next = zoneIndex.find(neighbour);
+                if (next != nullptr && hops[*next] == -1) {
+                    hops[*next] = hops[current] + 1;
+                    queue.push_back(*next);
+                }
+            }
+        }
+
+        // Unreachable zones are left out; allocateSlot() falls back to the
+        // load index for those
+        std::vector<OverflowCandidate> order;
+        order.reserve(queue.size() - 1);
+        for (int i = 1; i < (int)queue.size(); i++) {
+            Zone* zone = zones[queue[i]];
+            order.emplace_back(zone, hops[queue[i]], zone->getFacilityPosition());
+        }
+        zones[source]->setOverflowOrder(std::move(order));
     }
+    overflowOrdersDirty = false;
 }
 
 ParkingSlot* AllocationEngine::allocateSlot(Vehicle* vehicle, ParkingRequest* parkingRequest) {
     if (vehicle == nullptr || parkingRequest == nullptr) {
         return nullptr;
     }
+    return allocateSlotInZone(findZoneByID(parkingRequest->getRequestedZoneID()), parkingRequest);
+}
 
-    // Strategy 1: Try to allocate in requested zone
-    Zone* requestedZone = findZoneByID(parkingRequest->getRequestedZoneID());
-    if (requestedZone != nullptr) {
-        ParkingSlot* slot = requestedZone->findAvailableSlot();
-        if (slot != nullptr) {
-            slot->allocate();
-            requestedZone->refreshCapacity();  // Refresh available counts
-            parkingRequest->setAllocatedSlotID(slot->getSlotID());  // Store slot ID
-            parkingRequest->updateState(RequestState::ALLOCATED);
-            return slot;
-        }
+ParkingSlot* AllocationEngine::allocateSlotInZone(Zone* requestedZone, ParkingRequest* parkingRequest) {
+    switch (policyType) {
+        case AllocationPolicyType::FIRST_FIT:
+            return allocateWith<FirstFitPolicy>(requestedZone, parkingRequest);
+        case AllocationPolicyType::LEAST_LOADED:
+            return allocateWith<LeastLoadedPolicy>(requestedZone, parkingRequest);
+        case AllocationPolicyType::PACK_DENSELY:
+            return allocateWith<PackDenselyPolicy>(requestedZone, parkingRequest);
+        case AllocationPolicyType::NEAREST_ADJACENT:
+        default:
+            return allocateWith<NearestAdjacentPolicy>(requestedZone, parkingRequest);
     }
+}
 
-    // Strategy 2: Try other zones with penalty
-    Node<Zone*>* current = allZones.getHead();
-    while (current != nullptr) {
-        Zone* zone = current->data;
-        if (zone != nullptr && zone->getZoneID() != parkingRequest->getRequestedZoneID()) {
-            ParkingSlot* slot = zone->findAvailableSlot();
-            if (slot != nullptr) {
-                slot->allocate();
-                zone->refreshCapacity();  // Refresh available counts
-                parkingRequest->setAllocatedSlotID(slot->getSlotID());  // Store slot ID
-                parkingRequest->updateState(RequestState::ALLOCATED);
-                parkingRequest->addPenaltyCost(10.0); // Cross-zone penalty
-                std::cout << "[Info] Cross-zone penalty applied: $10.0" << std::endl;
-                return slot;
-            }
+void AllocationEngine::commitPlacement(const SlotPlacement& placement, ParkingRequest* parkingRequest) {
+    ParkingSlot* slot = placement.slot;   // Already taken by claimSlotInZone()
+    parkingRequest->setAllocatedSlot(slot->getSlotID(), slot->getHandle());
+    parkingRequest->updateState(RequestState::ALLOCATED);
+    if (placement.penalty > 0.0) {
+        parkingRequest->addPenaltyCost(placement.penalty);
+        if (verbose) {
+            std::cout << "[Info] Cross-zone penalty applied: $" << placement.penalty
+                      << " (Zone " << placement.zone->getZoneID() << ")" << std::endl;
         }
-        current = current->next;
-    }
-
-    return nullptr; // No slot available anywhere
-}
-
-bool AllocationEngine::freeSlot(int slotID) {
-    // Search for the slot in all zones
-    Node<Zone*>* zoneNode = allZones.getHead();
-    while (zoneNode != nullptr) {
-        Zone* zone = zoneNode->data;
-        if (zone != nullptr) {
-            // Search through all parking areas in this zone
-            auto& areas = zone->getParkingAreas();
-            Node<ParkingArea*>* areaNode = areas.getHead();
-            while (areaNode != nullptr) {
-                ParkingArea* area = areaNode->data;
-                if (area != nullptr) {
-                    ParkingSlot* slot = area->findSlotByID(slotID);
-                    if (slot != nullptr) {
-                        slot->free();  // Free the slot
-                        zone->refreshCapacity();  // Refresh available counts
-                        std::cout << "✅ Slot " << slotID << " has been freed\n";
-                        return true;
-                    }
-                }
-                areaNode = areaNode->next;
-            }
+    }
+}
+
+void AllocationEngine::setAllocationPolicy(AllocationPolicyType type) {
+    policyType = type;
+}
+
+AllocationPolicyType AllocationEngine::getAllocationPolicy() const {
+    return policyType;
+}
+
+ParkingSlot* AllocationEngine::claimSlotInZone(Zone* zone, SlotSize size) {
+    if (zone == nullptr) return nullptr;
+    if (zone->getAvailableSlots(size) == 0) return nullptr;   // O(1) counter check
+
+    // No lock: the slot's CAS decides between racing claimers
+    return zone->claimAvailableSlot(size);
+}
+
+const std::vector<OverflowCandidate>& AllocationEngine::getOverflowOrder(Zone* zone) {
+    if (overflowOrdersDirty) {
+        std::unique_lock<std::mutex> facilityLock = lockFacility();
+        if (overflowOrdersDirty) {   // Another thread may have rebuilt while we waited
+            rebuildOverflowOrders();
         }
-        zoneNode = zoneNode->next;
+    }
+    return zone->getOverflowOrder();
+}
+
+// The queries below read atomic bitmap words and load index cells without
+// the facility lock, so concurrent allocations never queue behind each other
+// here. A result can be stale by one in-flight update; callers only use it
+// to pick where to claim, and the slot's CAS decides.
+bool AllocationEngine::hasFreeSlotAt(int position, SlotSize size) const {
+    return nonFullZonesBySize[slotSizeIndex(size)].test(position);
+}
+
+int AllocationEngine::getZoneAvailableSlots(Zone* zone, SlotSize size) const {
+    return zone->getAvailableSlots(size);
+}
+
+Zone* AllocationEngine::getZoneAtPosition(int position) const {
+    if (position < 0 || position >= (int)zonesByPosition.size()) return nullptr;
+    return zonesByPosition[position];
+}
+
+int AllocationEngine::getZonePositionCount() const {
+    return (int)zonesByPosition.size();
+}
+
+ParkingSlot* AllocationEngine::resolveSlot(SlotHandle handle) const {
+    if (!handle.isValid()) return nullptr;
+    Zone* zone = findZoneByID(handle.getZoneID());
+    if (zone == nullptr) return nullptr;
+    ParkingArea* area = zone->getAreaAt(handle.getAreaIndex());
+    if (area == nullptr) return nullptr;
+    return area->getSlotAt(handle.getSlotIndex());
+}
+
+bool AllocationEngine::freeSlot(SlotHandle handle) {
+    ParkingSlot* slot = resolveSlot(handle);
+    if (slot == nullptr) {
+        std::cerr << "❌ ERROR: Slot handle " << handle.value << " not found!\n";
+        return false;
     }
     
-    std::cerr << "❌ ERROR: Slot " << slotID << " not found!\n";
-    return false;
+    slot->free();   // Atomic release; area, zone and facility counters update through the slot
+    if (verbose) {
+        std::cout << "✅ Slot " << slot->getSlotID() << " in Zone " << handle.getZoneID() << " has been freed\n";
+    }
+    return true;
 }
 
-DoublyLinkedList<Zone*>& AllocationEngine::getAllZones() {
+SlotMap<Zone*>& AllocationEngine::getAllZones() {
     return allZones;
-}
\ No newline at end of file
+}
+
+int AllocationEngine::getTotalCapacity() const {
+    return facilityCapacity;
+}
+
+int AllocationEngine::getTotalAvailableSlots() const {
+    return facilityAvailableSlots;
+}
+
+int AllocationEngine::getTotalAvailableSlots(SlotSize size) const {
+    return facilityAvailableBySize[slotSizeIndex(size)];
+}
+
+// A full zone at the root means every zone is full, or a refresh is still
+// pending; the non-full bitmap tells the two apart
+Zone* AllocationEngine::getMostAvailableZone() const {
+    int position = loadIndex.mostAvailable();
+    if (position == -1 || loadIndex.getAvailableAt(position) == 0) return findAnyNonFullZone();
+    return zonesByPosition[position];
+}
+
+Zone* AllocationEngine::findAnyNonFullZone() const {
+    int position = nonFullZones.findFirstSet();
+    return position == -1 ? nullptr : zonesByPosition[position];
+}
+
+Zone* AllocationEngine::getMostAvailableZone(SlotSize size) const {
+    const ZoneLoadIndex& sizedIndex = loadIndexBySize[slotSizeIndex(size)];
+    int position = sizedIndex.mostAvailable();
+    if (position == -1 || sizedIndex.getAvailableAt(position) == 0) return findAnyNonFullZone(size);
+    return zonesByPosition[position];
+}
+
+Zone* AllocationEngine::findAnyNonFullZone(SlotSize size) const {
+    int position = nonFullZonesBySize[slotSizeIndex(size)].findFirstSet();
+    return position == -1 ? nullptr : zonesByPosition[position];
+}
+
+bool AllocationEngine::isFacilityFull() const {
+    return facilityAvailableSlots <= 0;
+}
+
+void AllocationEngine::setVerbose(bool enabled) {
+    verbose = enabled;
+}
+
+bool AllocationEngine::isVerbose() const {
+    return verbose;
+}
+
+void AllocationEngine::setThreadSafe(bool enabled) {
+    threadSafe = enabled;
+}
+
+bool AllocationEngine::isThreadSafe() const {
+    return threadSafe;
+}
+
+std::unique_lock<std::mutex> AllocationEngine::lockZone(Zone* zone) const {
+    if (!threadSafe || zone == nullptr) return std::unique_lock<std::mutex>();
+    return std::unique_lock<std::mutex>(zone->getSlotMutex());
+}
+
+std::unique_lock<std::mutex> AllocationEngine::lockFacility() const {
+    if (!threadSafe) return std::unique_lock<std::mutex>();
+    return std::unique_lock<std::mutex>(facilityMutex);
+}
+
+void AllocationEngine::adjustFacilityCounts(Zone* zone, SlotSize size, int capacityDelta, int availableDelta) {
+    // No lock: every counter is an atomic and every bitmap bit belongs to one zone
+    if (capacityDelta != 0) facilityCapacity.fetch_add(capacityDelta);
+    if (availableDelta == 0) return;
+    
+    int sizeIndex = slotSizeIndex(size);
+    int position = zone->getFacilityPosition();
+    facilityAvailableSlots.fetch_add(availableDelta);
+    facilityAvailableBySize[sizeIndex].fetch_add(availableDelta);
+    if (availableDelta > 0) {
+        nonFullZones.set(position);
+        nonFullZonesBySize[sizeIndex].set(position);
+    } else {
+        // Clear the bit when the zone fills, then re-check: a slot freed in
+        // the meantime has already set the bit, and our reset must not hide it
+        if (zone->getAvailableSlots() == 0) {
+            nonFullZones.reset(position);
+            if (zone->getAvailableSlots() > 0) nonFullZones.set(position);
+        }
+        if (zone->getAvailableSlots(size) == 0) {
+            nonFullZonesBySize[sizeIndex].reset(position);
+            if (zone->getAvailableSlots(size) > 0) nonFullZonesBySize[sizeIndex].set(position);
+        }
+    }
+    
+    staleLoadPositionsBySize[sizeIndex].set(position);
+    staleLoadPositions.set(position);   // Last: refreshLoadIndexes() loops on this bitmap
+    refreshLoadIndexes();
+}
+
+// The trees need one writer at a time, but no claim should wait for another
+// zone's: a writer that loses the try-lock leaves its zone flagged and the
+// holder, which re-checks the flags after unlocking, refreshes it. Leaves are
+// read from the zone counters here, so a late refresh is never a wrong one.
+void AllocationEngine::refreshLoadIndexes() {
+    while (staleLoadPositions.findFirstSet() != -1) {
+        std::unique_lock<std::mutex> indexLock(loadIndexMutex, std::try_to_lock);
+        if (!indexLock.owns_lock()) return;
+        
+        for (int position = staleLoadPositions.findFirstSet(); position != -1;
+             position = staleLoadPositions.findFirstSet()) {
+            staleLoadPositions.reset(position);   // Before reading: a later change flags it again
+            loadIndex.update(position, zonesByPosition[position]->getAvailableSlots());
+        }
+        for (int s = 0; s < SLOT_SIZE_COUNT; s++) {
+            SlotSize size = static_cast<SlotSize>(s);
+            for (int position = staleLoadPositionsBySize[s].findFirstSet(); position != -1;
+                 position = staleLoadPositionsBySize[s].findFirstSet()) {
+                staleLoadPositionsBySize[s].reset(position);
+                loadIndexBySize[s].update(position, zonesByPosition[position]->getAvailableSlots(size));
+            }
+        }
+    }
+}
@@ -0,0 +1,268 @@
+#include "AllocationSnapshot.h"
+#include "AllocationPolicies.h"
+#include "ParkingArea.h"
+
+AllocationSnapshot::AllocationSnapshot()
+    : overflowOrders(std::make_shared<OverflowTable>()),
+      positionsByZoneID(std::make_shared<std::unordered_map<int, int>>()),
+      policyType(AllocationPolicyType::NEAREST_ADJACENT) {
+    for (int s = 0; s < SLOT_SIZE_COUNT; s++) {
+        availableBySize[s] = 0;
+    }
+}
+
+AllocationSnapshot AllocationSnapshot::capture(AllocationEngine& engine) {
+    AllocationSnapshot snapshot;
+    snapshot.policyType = engine.getAllocationPolicy();
+
+    int zoneCount = engine.getZonePositionCount();
+    std::shared_ptr<OverflowTable> orders = std::make_shared<OverflowTable>(zoneCount);
+    std::shared_ptr<std::unordered_map<int, int>> positions = std::make_shared<std::unordered_map<int, int>>();
+    snapshot.zones.reserve(zoneCount);
+
+    for (int position = 0; position < zoneCount; position++) {
+        Zone* zone = engine.getZoneAtPosition(position);
+        std::shared_ptr<ZoneState> zoneState = std::make_shared<ZoneState>();
+        zoneState->zone = zone;
+        zoneState->closed = false;
+
+        for (int a = 0; zone->getAreaAt(a) != nullptr; a++) {
+            ParkingArea* area = zone->getAreaAt(a);
+            std::shared_ptr<AreaState> areaState = std::make_shared<AreaState>();
+            for (int s = 0; s < SLOT_SIZE_COUNT; s++) {
+                areaState->availableBySize[s] = area->copyAvailabilityBitmap(static_cast<SlotSize>(s));
+            }
+            zoneState->areas.push_back(areaState);
+        }
+        for (int s = 0; s < SLOT_SIZE_COUNT; s++) {
+            zoneState->availableBySize[s] = zone->getAvailableSlots(static_cast<SlotSize>(s));
+            snapshot.availableBySize[s] += zoneState->availableBySize[s];
+        }
+
+        snapshot.zones.push_back(zoneState);
+        (*orders)[position] = engine.getOverflowOrder(zone);
+        (*positions)[zone->getZoneID()] = position;
+    }
+
+    snapshot.overflowOrders = orders;
+    snapshot.positionsByZoneID = positions;
+    return snapshot;
+}
+
+// ============================================================================
+// COPY ON WRITE
+// ============================================================================
+
+AllocationSnapshot::ZoneState& AllocationSnapshot::mutableZone(int position) {
+    std::shared_ptr<ZoneState>& zoneState = zones[position];
+    if (zoneState.use_count() > 1) {
+        zoneState = std::make_shared<ZoneState>(*zoneState);   // Copies area pointers, not bitmaps
+    }
+    return *zoneState;
+}
+
+AllocationSnapshot::AreaState& AllocationSnapshot::mutableArea(ZoneState& zoneState, int areaIndex) {
+    std::shared_ptr<AreaState>& areaState = zoneState.areas[areaIndex];
+    if (areaState.use_count() > 1) {
+        areaState = std::make_shared<AreaState>(*areaState);
+    }
+    return *areaState;
+}
+
+const AllocationSnapshot::ZoneState* AllocationSnapshot::zoneStateFor(Zone* zone) const {
+    if (zone == nullptr) return nullptr;
+    int position = zone->getFacilityPosition();
+    if (position < 0 || position >= (int)zones.size() || zones[position]->zone != zone) return nullptr;
+    return zones[position].get();
+}
+
+int AllocationSnapshot::positionOf(int zoneID) const {
+    std::unordered_map<int, int>::const_iterator it = positionsByZoneID->find(zoneID);
+    return it == positionsByZoneID->end() ? -1 : it->second;
+}
+
+// ============================================================================
+// SCENARIO CHANGES
+// ============================================================================
+
+template <typename Policy>
+SimulatedAllocation AllocationSnapshot::allocateWith(Zone* requestedZone, SlotSize required) {
+    SimulatedAllocation result;
+    if (isFacilityFull()) {
+        return result;
+    }
+
+    // Same best-fit walk as AllocationEngine::allocateWith()
+    for (int s = slotSizeIndex(required); s < SLOT_SIZE_COUNT; s++) {
+        if (availableBySize[s] == 0) continue;
+        SlotPlacement placement = Policy::place(*this, requestedZone, static_cast<SlotSize>(s));
+        if (placement.slot == nullptr) continue;   // Otherwise already taken by claimSlotInZone()
+
+        result.allocated = true;
+        result.zoneID = placement.zone->getZoneID();
+        result.slotID = placement.slot->getSlotID();
+        result.penaltyCost = placement.penalty;
+        result.handle = placement.slot->getHandle();
+        return result;
+    }
+    return result;
+}
+
+SimulatedAllocation AllocationSnapshot::allocate(int requestedZoneID, VehicleType type) {
+    int position = positionOf(requestedZoneID);
+    Zone* requestedZone = (position != -1) ? zones[position]->zone : nullptr;
+    SlotSize required = requiredSlotSize(type);
+
+    switch (policyType) {
+        case AllocationPolicyType::FIRST_FIT:
+            return allocateWith<FirstFitPolicy>(requestedZone, required);
+        case AllocationPolicyType::LEAST_LOADED:
+            return allocateWith<LeastLoadedPolicy>(requestedZone, required);
+        case AllocationPolicyType::PACK_DENSELY:
+            return allocateWith<PackDenselyPolicy>(requestedZone, required);
+        case AllocationPolicyType::NEAREST_ADJACENT:
+        default:
+            return allocateWith<NearestAdjacentPolicy>(requestedZone, required);
+    }
+}
+
+bool AllocationSnapshot::release(SlotHandle handle) {
+    if (!handle.isValid()) return false;
+    int position = positionOf(handle.getZoneID());
+    if (position == -1) return false;
+
+    const ZoneState& current = *zones[position];
+    int areaIndex = handle.getAreaIndex();
+    if (areaIndex >= (int)current.areas.size()) return false;
+    ParkingSlot* slot = current.zone->getAreaAt(areaIndex)->getSlotAt(handle.getSlotIndex());
+    if (slot == nullptr) return false;
+
+    int s = slotSizeIndex(slot->getSize());
+    if (current.areas[areaIndex]->availableBySize[s].test(handle.getSlotIndex())) {
+        return false;   // Already free in this snapshot
+    }
+
+    ZoneState& zoneState = mutableZone(position);
+    mutableArea(zoneState, areaIndex).availableBySize[s].set(handle.getSlotIndex());
+    if (!zoneState.closed) {
+        zoneState.availableBySize[s]++;
+        availableBySize[s]++;
+    }
+    return true;
+}
+
+bool AllocationSnapshot::closeZone(int zoneID) {
+    int position = positionOf(zoneID);
+    if (position == -1) return false;
+
+    ZoneState& zoneState = mutableZone(position);
+    for (int s = 0; s < SLOT_SIZE_COUNT; s++) {
+        availableBySize[s] -= zoneState.availableBySize[s];
+        zoneState.availableBySize[s] = 0;   // Bitmaps are kept; the zone is just never searched
+    }
+    zoneState.closed = true;
+    return true;
+}
+
+void AllocationSnapshot::setAllocationPolicy(AllocationPolicyType type) {
+    policyType = type;
+}
+
+// ============================================================================
+// SEARCH PRIMITIVES
+// ============================================================================
+
+ParkingSlot* AllocationSnapshot::claimSlotInZone(Zone* zone, SlotSize size) {
+    const ZoneState* zoneState = zoneStateFor(zone);
+    int s = slotSizeIndex(size);
+    if (zoneState == nullptr || zoneState->availableBySize[s] == 0) return nullptr;
+
+    // Lowest free slot in the lowest area, matching Zone::findAvailableSlot()
+    for (int a = 0; a < (int)zoneState->areas.size(); a++) {
+        int slotIndex = zoneState->areas[a]->availableBySize[s].peekFirstSet();
+        if (slotIndex == -1) continue;
+
+        ZoneState& writable = mutableZone(zone->getFacilityPosition());
+        mutableArea(writable, a).availableBySize[s].reset(slotIndex);
+        writable.availableBySize[s]--;
+        availableBySize[s]--;
+        return zone->getAreaAt(a)->getSlotAt(slotIndex);
+    }
+    return nullptr;
+}
+
+const std::vector<OverflowCandidate>& AllocationSnapshot::getOverflowOrder(Zone* zone) {
+    static const std::vector<OverflowCandidate> none;
+    if (zoneStateFor(zone) == nullptr) return none;
+    return (*overflowOrders)[zone->getFacilityPosition()];
+}
+
+bool AllocationSnapshot::hasFreeSlotAt(int position, SlotSize size) const {
+    if (position < 0 || position >= (int)zones.size()) return false;
+    return zones[position]->availableBySize[slotSizeIndex(size)] > 0;
+}
+
+int AllocationSnapshot::getZoneAvailableSlots(Zone* zone, SlotSize size) const {
+    const ZoneState* zoneState = zoneStateFor(zone);
+    return zoneState == nullptr ? 0 : zoneState->availableBySize[slotSizeIndex(size)];
+}
+
+Zone* AllocationSnapshot::getZoneAtPosition(int position) const {
+    if (position < 0 || position >= (int)zones.size()) return nullptr;
+    return zones[position]->zone;
+}
+
+int AllocationSnapshot::getZonePositionCount() const {
+    return (int)zones.size();
+}
+
+Zone* AllocationSnapshot::getMostAvailableZone(SlotSize size) const {
+    int s = slotSizeIndex(size);
+    int best = -1;
+    for (int position = 0; position < (int)zones.size(); position++) {
+        if (zones[position]->availableBySize[s] == 0) continue;
+        if (best == -1 || zones[position]->availableBySize[s] > zones[best]->availableBySize[s]) {
+            best = position;   // Lowest position wins ties, as in ZoneLoadIndex
+        }
+    }
+    return best == -1 ? nullptr : zones[best]->zone;
+}
+
+Zone* AllocationSnapshot::findAnyNonFullZone(SlotSize size) const {
+    for (int position = 0; position < (int)zones.size(); position++) {
+        if (hasFreeSlotAt(position, size)) {
+            return zones[position]->zone;
+        }
+    }
+    return nullptr;
+}
+
+// ============================================================================
+// GETTERS
+// ============================================================================
+
+int AllocationSnapshot::getTotalAvailableSlots() const {
+    int total = 0;
+    for (int s = 0; s < SLOT_SIZE_COUNT; s++) {
+        total += availableBySize[s];
+    }
+    return total;
+}
+
+int AllocationSnapshot::getTotalAvailableSlots(SlotSize size) const {
+    return availableBySize[slotSizeIndex(size)];
+}
+
+int AllocationSnapshot::getAvailableSlots(int zoneID) const {
+    int position = positionOf(zoneID);
+    if (position == -1) return 0;
+    int total = 0;
+    for (int s = 0; s < SLOT_SIZE_COUNT; s++) {
+        total += zones[position]->availableBySize[s];
+    }
+    return total;
+}
+
+bool AllocationSnapshot::isFacilityFull() const {
+    return getTotalAvailableSlots() <= 0;
+}
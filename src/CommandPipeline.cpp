@@ -0,0 +1,158 @@
+#include "CommandPipeline.h"
+#include "ParkingSystem.h"
+#include <utility>
+#include <vector>
+
+CommandPipeline::CommandPipeline(ParkingSystem* system, int batchSize)
+    : parkingSystem(system), maxBatch(batchSize > 0 ? batchSize : DEFAULT_MAX_BATCH),
+      publishAfterBatch(false), running(false), idle(false),
+      commandsApplied(0), batchesApplied(0) {}
+
+CommandPipeline::~CommandPipeline() {
+    stop();
+}
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+void CommandPipeline::start() {
+    if (running.exchange(true)) return;
+    engineThread = std::thread(&CommandPipeline::engineLoop, this);
+}
+
+void CommandPipeline::stop() {
+    if (!running.exchange(false)) return;
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        idle.store(false);
+    }
+    wakeCondition.notify_one();
+    engineThread.join();
+}
+
+bool CommandPipeline::isRunning() const {
+    return running.load();
+}
+
+void CommandPipeline::setPublishAfterBatch(bool enabled) {
+    publishAfterBatch.store(enabled);
+}
+
+// ============================================================================
+// SUBMISSION
+// ============================================================================
+
+void CommandPipeline::enqueue(PipelineCommand command) {
+    queue.push(std::move(command));
+    // Only a sleeping engine needs the mutex; the common case stays lock-free
+    if (idle.load() && idle.exchange(false)) {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        wakeCondition.notify_one();
+    }
+}
+
+std::future<bool> CommandPipeline::submit(PipelineCommandType type, const std::string& vehicleID,
+                                          int zoneID, VehicleType vehicleType) {
+    PipelineCommand command;
+    command.type = type;
+    command.vehicleID = vehicleID;
+    command.zoneID = zoneID;
+    command.vehicleType = vehicleType;
+    command.completion.reset(new std::promise<bool>());
+    std::future<bool> result = command.completion->get_future();
+    enqueue(std::move(command));
+    return result;
+}
+
+void CommandPipeline::submit(PipelineCommandType type, const std::string& vehicleID, PipelineCallback callback,
+                             int zoneID, VehicleType vehicleType) {
+    PipelineCommand command;
+    command.type = type;
+    command.vehicleID = vehicleID;
+    command.zoneID = zoneID;
+    command.vehicleType = vehicleType;
+    command.callback = std::move(callback);
+    enqueue(std::move(command));
+}
+
+// ============================================================================
+// ENGINE THREAD
+// ============================================================================
+
+void CommandPipeline::engineLoop() {
+    while (true) {
+        if (drainBatch() > 0) continue;
+
+        // Announce the sleep before the final emptiness check: a producer
+        // that pushes after the check sees idle and wakes us
+        idle.store(true);
+        if (!queue.isEmpty()) {
+            idle.store(false);
+            continue;
+        }
+        if (!running.load()) {
+            idle.store(false);
+            return;   // stop() was called and everything before it is applied
+        }
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeCondition.wait(lock, [this]() { return !idle.load() || !running.load(); });
+        idle.store(false);
+    }
+}
+
+int CommandPipeline::drainBatch() {
+    std::vector<PipelineCommand> batch;
+    std::vector<bool> results;
+    PipelineCommand command;
+    while ((int)batch.size() < maxBatch && queue.tryPop(command)) {
+        results.push_back(apply(command));
+        batch.push_back(std::move(command));
+    }
+    if (batch.empty()) return 0;
+
+    // Publish before completing, so a producer whose future has resolved
+    // already finds its command in getPublishedDashboard(); a batch whose
+    // commands all failed leaves the current version standing
+    if (publishAfterBatch.load()) {
+        parkingSystem->publishIfChanged();
+    }
+    for (size_t i = 0; i < batch.size(); i++) {
+        if (batch[i].completion) {
+            batch[i].completion->set_value(results[i]);
+        } else if (batch[i].callback) {
+            batch[i].callback(results[i]);
+        }
+    }
+    commandsApplied += (long long)batch.size();
+    batchesApplied++;
+    return (int)batch.size();
+}
+
+bool CommandPipeline::apply(const PipelineCommand& command) {
+    switch (command.type) {
+        case PipelineCommandType::CREATE:
+            return parkingSystem->createRequest(command.vehicleID, command.zoneID, command.vehicleType) != nullptr;
+        case PipelineCommandType::ALLOCATE:
+            return parkingSystem->allocateSlotForRequest(command.vehicleID);
+        case PipelineCommandType::OCCUPY:
+            return parkingSystem->occupyRequest(command.vehicleID);
+        case PipelineCommandType::RELEASE:
+            return parkingSystem->releaseRequest(command.vehicleID);
+        case PipelineCommandType::CANCEL:
+            return parkingSystem->cancelRequest(command.vehicleID);
+    }
+    return false;
+}
+
+// ============================================================================
+// GETTERS
+// ============================================================================
+
+long long CommandPipeline::getCommandsApplied() const {
+    return commandsApplied.load();
+}
+
+long long CommandPipeline::getBatchesApplied() const {
+    return batchesApplied.load();
+}
@@ -14,11 +14,13 @@
 #include <QDateTime>
 #include <QAbstractItemModel>
 #include <sstream>
+#include <algorithm>
+#include <iterator>
 #include <iomanip>
 #include <cstdint>
 #include <vector>
 MainWindow::MainWindow(QWidget *parent)
-    : QMainWindow(parent), requestLogArea(nullptr), parkingSystem(nullptr) {
+    : QMainWindow(parent), requestLogArea(nullptr), parkingSystem(nullptr), publishTimer(nullptr) {
     try {
         setWindowTitle("DSA Parking System - Management Interface");
         setGeometry(100, 100, 1400, 900);
@@ -71,9 +73,17 @@ MainWindow::MainWindow(QWidget *parent)
         }
         zone3->addParkingArea(area6);
         parkingSystem->addZone(zone3);
+        parkingSystem->publishDashboard();   // First snapshot; later ones come from the publish timer
         
         setupUI();
         
+        // Dashboard reads only ever take the published snapshot. Publishing
+        // is throttled to the timer and skipped when nothing changed, so
+        // request handling never pays for a dashboard recompute
+        publishTimer = new QTimer(this);
+        connect(publishTimer, &QTimer::timeout, this, &MainWindow::onPublishTimer);
+        publishTimer->start(PUBLISH_INTERVAL_MS);
+        
         // Only call these if requestLogArea was successfully created
         if (requestLogArea != nullptr) {
             logMessage("System initialized successfully");
@@ -91,6 +101,12 @@ MainWindow::~MainWindow() {
     delete parkingSystem;
 }
 
+void MainWindow::onPublishTimer() {
+    if (parkingSystem != nullptr && parkingSystem->publishIfChanged() != 0) {
+        updateDashboard();
+    }
+}
+
 void MainWindow::setupUI() {
     QWidget* centralWidget = new QWidget(this);
     setCentralWidget(centralWidget);
@@ -739,7 +755,11 @@ void MainWindow::updateDashboard() {
             return;
         }
         
-        DashboardStats stats = parkingSystem->getDashboardStats();
+        // Published by onPublishTimer() after changes, so the UI only
+        // renders the latest immutable snapshot
+        DashboardSnapshot snapshot = parkingSystem->getPublishedDashboard();
+        if (!snapshot.isValid()) return;
+        const DashboardStats& stats = *snapshot;
         
         if (totalRequestsLabel) totalRequestsLabel->setText(QString::number(stats.totalRequests));
         if (allocatedLabel) allocatedLabel->setText(QString::number(stats.requestsAllocated));
@@ -754,11 +774,10 @@ void MainWindow::updateDashboard() {
         // Populate zone availability table
         if (zoneAvailabilityTable) {
             zoneAvailabilityTable->setRowCount(0);
-            auto zoneNode = stats.zoneStatuses.getHead();
             int row = 0;
             int maxRows = 1000;  // Safety limit to prevent infinite loop
-            while (zoneNode != nullptr && row < maxRows) {
-                ZoneSlotStatus zoneStatus = zoneNode->data;
+            for (const ZoneSlotStatus& zoneStatus : stats.zoneStatuses) {
+                if (row >= maxRows) break;
                 
                 zoneAvailabilityTable->insertRow(row);
                 zoneAvailabilityTable->setItem(row, 0, new QTableWidgetItem(QString::number(zoneStatus.zoneID)));
@@ -768,7 +787,6 @@ void MainWindow::updateDashboard() {
                 zoneAvailabilityTable->setItem(row, 4, new QTableWidgetItem(QString::number(zoneStatus.utilization, 'f', 1) + "%"));
                 
                 row++;
-                zoneNode = zoneNode->next;
             }
             if (row >= maxRows) {
                 qWarning() << "Zone table update exceeded max rows - possible infinite loop!";
@@ -800,25 +818,8 @@ void MainWindow::updateZoneList() {
         
         // Create a safe copy of zone pointers to avoid list corruption
         std::vector<Zone*> zonePtrs;
-        auto tempNode = zonesList.getHead();
-        int tempCount = 0;
-        
-        while (tempNode != nullptr && tempCount < 10000) {
-            // Validate pointer
-            if ((intptr_t)tempNode < 0x1000 || (intptr_t)tempNode > 0x7FFFFFFF0000) {
-                break;
-            }
-            
-            if (tempNode->data != nullptr) {
-                if ((intptr_t)(tempNode->data) >= 0x1000 && (intptr_t)(tempNode->data) <= 0x7FFFFFFF0000) {
-                    zonePtrs.push_back(tempNode->data);
-                }
-            }
-            
-            auto nextPtr = tempNode->next;
-            tempNode = nextPtr;
-            tempCount++;
-        }
+        std::copy_if(zonesList.begin(), zonesList.end(), std::back_inserter(zonePtrs),
+                     [](Zone* zone) { return zone != nullptr; });
         
         // Now populate combo box from the safe copy
         for (Zone* zone : zonePtrs) {
@@ -862,7 +863,13 @@ void MainWindow::onShowZoneAnalytics() {
         zoneAnalyticsTable->setRowCount(0);
         logMessage("Table cleared");
         
-        DashboardStats stats = parkingSystem->getDashboardStats();
+        // At most one publish interval behind the last mutation
+        DashboardSnapshot snapshot = parkingSystem->getPublishedDashboard();
+        if (!snapshot.isValid()) {
+            logMessage("ERROR: no dashboard published yet");
+            return;
+        }
+        const DashboardStats& stats = *snapshot;
         
         logMessage(QString("Got %1 zones").arg(stats.zoneStatuses.getSize()));
         
@@ -878,13 +885,12 @@ void MainWindow::onShowZoneAnalytics() {
         logMessage("Populating analytics table...");
         std::cout.flush();
         // Populate with actual zone data
-        auto zoneNode = stats.zoneStatuses.getHead();
         int row = 0;
         int maxRows = 1000;
         
-        while (zoneNode != nullptr && row < maxRows) {
+        for (const ZoneSlotStatus& zoneStatus : stats.zoneStatuses) {
+            if (row >= maxRows) break;
             logMessage(QString("Processing row %1...").arg(row));
-            ZoneSlotStatus zoneStatus = zoneNode->data;
             
             zoneAnalyticsTable->insertRow(row);
             zoneAnalyticsTable->setItem(row, 0, new QTableWidgetItem(QString::number(zoneStatus.zoneID)));
@@ -894,7 +900,6 @@ void MainWindow::onShowZoneAnalytics() {
             zoneAnalyticsTable->setItem(row, 4, new QTableWidgetItem(QString::number(zoneStatus.utilization, 'f', 1) + "%"));
             
             row++;
-            zoneNode = zoneNode->next;
         }
         
         logMessage(QString("=== Zone analytics complete - %1 zones displayed ===").arg(row));
@@ -926,18 +931,15 @@ void MainWindow::onShowFullHistory() {
         int row = 0;
         int requestID = 1;
         int maxRows = 10000;
-        // Iterate through all requests in master history
-        auto currentNode = masterHistory.getHead();
-        
-        if (currentNode == nullptr) {
+        if (masterHistory.isEmpty()) {
             logMessage("⚠️ Master history is empty - no requests created yet");
             return;
         }
         
-        while (currentNode != nullptr && row < maxRows) {
-            if (currentNode->data != nullptr) {
-                ParkingRequest* req = currentNode->data;
-                
+        // Iterate through all requests in master history
+        for (ParkingRequest* req : masterHistory) {
+            if (row >= maxRows) break;
+            if (req != nullptr) {
                 // Insert row
                 historyTable->insertRow(row);
                 
@@ -967,7 +969,6 @@ void MainWindow::onShowFullHistory() {
                 requestID++;
                 row++;
             }
-            currentNode = currentNode->next;
         }
         
         logMessage(QString("✓ Full history loaded - %1 request(s) displayed").arg(row));
@@ -1272,11 +1273,9 @@ void MainWindow::onShowRollbackStatus() {
         status += "No active requests in system\n";
     } else {
         status += "Vehicles in System:\n";
-        auto node = activeRequests.getHead();
         int count = 1;
-        while (node != nullptr) {
-            if (node->data != nullptr) {
-                ParkingRequest* req = node->data;
+        for (ParkingRequest* req : activeRequests) {
+            if (req != nullptr) {
                 status += QString("  %1. Vehicle: %2 | Status: %3 | Zone: %4\n")
                     .arg(count)
                     .arg(QString::fromStdString(req->getVehicleID()))
@@ -1284,7 +1283,6 @@ void MainWindow::onShowRollbackStatus() {
                     .arg(req->getRequestedZoneID());
                 count++;
             }
-            node = node->next;
         }
     }
     
@@ -1,11 +1,20 @@
 #include "ParkingArea.h"
 #include "ParkingSlot.h"
+#include "SlotBitmap.h"
+#include "Zone.h"
 #include <iostream>
 #include <vector>
 #include <cstdint>
 
-ParkingArea::ParkingArea(int id) : areaID(id), slotsPtr(0), totalSlots(0), availableSlots(0) {
+ParkingArea::ParkingArea(int id)
+    : areaID(id), slotsPtr(0), availability(new AtomicSlotBitmap()),
+      availabilityBySize(new AtomicSlotBitmap[SLOT_SIZE_COUNT]), totalSlots(0), availableSlots(0),
+      ownerZone(nullptr), ownerZoneID(0), areaIndex(-1) {
     slotsPtr = (intptr_t)(new std::vector<ParkingSlot*>());
+    for (int s = 0; s < SLOT_SIZE_COUNT; s++) {
+        totalBySize[s] = 0;
+        availableBySize[s] = 0;
+    }
 }
 
 ParkingArea::~ParkingArea() {
@@ -13,30 +22,90 @@ ParkingArea::~ParkingArea() {
         delete (std::vector<ParkingSlot*>*)(slotsPtr);
         slotsPtr = 0;
     }
+    delete availability;
+    delete[] availabilityBySize;
 }
 
 void ParkingArea::addSlot(ParkingSlot* slot) {
     if (slot != nullptr && slotsPtr != 0) {
         auto* slotVec = (std::vector<ParkingSlot*>*)(slotsPtr);
+        int slotIndex = (int)slotVec->size();
+        if (areaIndex != -1) {
+            slot->setHandle(SlotHandle(ownerZoneID, areaIndex, slotIndex));
+        }
+        slot->attachToArea(this, slotIndex);
         slotVec->push_back(slot);
+        int sizeIndex = slotSizeIndex(slot->getSize());
+        availability->pushBack(slot->getIsAvailable());
+        for (int s = 0; s < SLOT_SIZE_COUNT; s++) {
+            availabilityBySize[s].pushBack(s == sizeIndex && slot->getIsAvailable());
+        }
         totalSlots++;
+        totalBySize[sizeIndex]++;
         if (slot->getIsAvailable()) {
             availableSlots++;
+            availableBySize[sizeIndex]++;
+        }
+        if (ownerZone != nullptr) {
+            ownerZone->onSlotAdded(areaIndex, slot);
         }
     }
 }
 
 ParkingSlot* ParkingArea::findAvailableSlot() {
     if (slotsPtr == 0) return nullptr;
+    // Scan the bitmap 64 slots at a time; only the chosen slot is touched
+    int slotIndex = availability->findFirstSet();
+    if (slotIndex == -1) return nullptr;
     auto* slotVec = (std::vector<ParkingSlot*>*)(slotsPtr);
-    for (auto slot : *slotVec) {
-        if (slot != nullptr && slot->getIsAvailable()) {
+    return (*slotVec)[slotIndex];
+}
+
+ParkingSlot* ParkingArea::findAvailableSlot(SlotSize size) {
+    if (slotsPtr == 0) return nullptr;
+    int slotIndex = availabilityBySize[slotSizeIndex(size)].findFirstSet();
+    if (slotIndex == -1) return nullptr;
+    auto* slotVec = (std::vector<ParkingSlot*>*)(slotsPtr);
+    return (*slotVec)[slotIndex];
+}
+
+ParkingSlot* ParkingArea::claimAvailableSlot(SlotSize size) {
+    if (slotsPtr == 0) return nullptr;
+    // A set bit is only a candidate: another claimer may win the slot's CAS
+    // first, in which case we continue with the next set bit
+    AtomicSlotBitmap& bitmap = availabilityBySize[slotSizeIndex(size)];
+    auto* slotVec = (std::vector<ParkingSlot*>*)(slotsPtr);
+    for (int slotIndex = bitmap.findFirstSet(); slotIndex != -1; slotIndex = bitmap.findNextSet(slotIndex + 1)) {
+        ParkingSlot* slot = (*slotVec)[slotIndex];
+        if (slot->allocate()) {
             return slot;
         }
     }
     return nullptr;
 }
 
+void ParkingArea::markSlotOccupied(int slotIndex, SlotSize size) {
+    int sizeIndex = slotSizeIndex(size);
+    availability->reset(slotIndex);
+    availabilityBySize[sizeIndex].reset(slotIndex);
+    availableSlots--;
+    availableBySize[sizeIndex]--;
+    if (ownerZone != nullptr) ownerZone->onSlotAllocated(areaIndex, size);
+}
+
+void ParkingArea::markSlotAvailable(int slotIndex, SlotSize size) {
+    int sizeIndex = slotSizeIndex(size);
+    availability->set(slotIndex);
+    availabilityBySize[sizeIndex].set(slotIndex);
+    availableSlots++;
+    availableBySize[sizeIndex]++;
+    if (ownerZone != nullptr) ownerZone->onSlotFreed(areaIndex, size);
+}
+
+void ParkingArea::offerFreeSlot(int slotIndex) {
+    if (ownerZone != nullptr) ownerZone->pushFreeSlot(getSlotAt(slotIndex));
+}
+
 ParkingSlot* ParkingArea::findSlotByID(int slotID) {
     if (slotsPtr == 0) return nullptr;
     auto* slotVec = (std::vector<ParkingSlot*>*)(slotsPtr);
@@ -48,6 +117,35 @@ ParkingSlot* ParkingArea::findSlotByID(int slotID) {
     return nullptr;
 }
 
+ParkingSlot* ParkingArea::getSlotAt(int slotIndex) const {
+    if (slotsPtr == 0) return nullptr;
+    auto* slotVec = (std::vector<ParkingSlot*>*)(slotsPtr);
+    if (slotIndex < 0 || slotIndex >= (int)slotVec->size()) return nullptr;
+    return (*slotVec)[slotIndex];
+}
+
+void ParkingArea::assignLocation(Zone* zone, int indexInZone) {
+    int zoneID = zone->getZoneID();
+    ownerZone = zone;
+    ownerZoneID = zoneID;
+    areaIndex = indexInZone;
+    if (slotsPtr == 0) return;
+    auto* slotVec = (std::vector<ParkingSlot*>*)(slotsPtr);
+    for (int i = 0; i < (int)slotVec->size(); i++) {
+        if ((*slotVec)[i] != nullptr) {
+            (*slotVec)[i]->setHandle(SlotHandle(zoneID, areaIndex, i));
+        }
+    }
+}
+
+int ParkingArea::getAreaIndex() const {
+    return areaIndex;
+}
+
+SlotBitmap ParkingArea::copyAvailabilityBitmap(SlotSize size) const {
+    return availabilityBySize[slotSizeIndex(size)].toSlotBitmap();
+}
+
 int ParkingArea::getAreaID() const { 
     return areaID; 
 }
@@ -57,21 +155,25 @@ int ParkingArea::getTotalSlots() const {
 }
 
 int ParkingArea::getAvailableSlots() const { 
-    return availableSlots; 
+    return availableSlots.load();
+}
+
+int ParkingArea::getTotalSlots(SlotSize size) const {
+    return totalBySize[slotSizeIndex(size)];
+}
+
+int ParkingArea::getAvailableSlots(SlotSize size) const {
+    return availableBySize[slotSizeIndex(size)].load();
 }
 
 void ParkingArea::refreshAvailableCount() {
-    if (slotsPtr == 0) return;
-    auto* slotVec = (std::vector<ParkingSlot*>*)(slotsPtr);
-    availableSlots = 0;
-    for (auto slot : *slotVec) {
-        if (slot != nullptr && slot->getIsAvailable()) {
-            availableSlots++;
-        }
+    availableSlots = availability->count();
+    for (int s = 0; s < SLOT_SIZE_COUNT; s++) {
+        availableBySize[s] = availabilityBySize[s].count();
     }
 }
 
 void ParkingArea::displayInfo() const {
     std::cout << "Area ID: " << areaID << ", Total Slots: " << totalSlots 
-              << ", Available: " << availableSlots << std::endl;
+              << ", Available: " << getAvailableSlots() << std::endl;
 }
\ No newline at end of file
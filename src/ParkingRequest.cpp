@@ -1,8 +1,9 @@
 #include "ParkingRequest.h"
 #include <iostream>
+#include <utility>
 
-ParkingRequest::ParkingRequest(const std::string& vID, int zoneID) 
-    : vehicleID(vID), requestedZoneID(zoneID), allocatedSlotID(-1), currentStatus(RequestState::REQUESTED), penaltyCost(0.0) {
+ParkingRequest::ParkingRequest(std::string vID, int zoneID, VehicleType type) 
+    : vehicleID(std::move(vID)), requestedZoneID(zoneID), vehicleType(type), allocatedSlotID(-1), currentStatus(RequestState::REQUESTED), penaltyCost(0.0) {
     // Initialize request time to current time (simplified)
 }
 
@@ -34,7 +35,7 @@ bool ParkingRequest::updateState(RequestState newState) {
     return false;
 }
 
-std::string ParkingRequest::getVehicleID() const { 
+const std::string& ParkingRequest::getVehicleID() const { 
     return vehicleID; 
 }
 
@@ -42,10 +43,18 @@ int ParkingRequest::getRequestedZoneID() const {
     return requestedZoneID; 
 }
 
+VehicleType ParkingRequest::getVehicleType() const {
+    return vehicleType;
+}
+
 int ParkingRequest::getAllocatedSlotID() const { 
     return allocatedSlotID; 
 }
 
+SlotHandle ParkingRequest::getAllocatedSlotHandle() const {
+    return allocatedSlotHandle;
+}
+
 DateTime ParkingRequest::getRequestTime() const { 
     return requestTime; 
 }
@@ -70,6 +79,24 @@ void ParkingRequest::setAllocatedSlotID(int slotID) {
     allocatedSlotID = slotID; 
 }
 
+void ParkingRequest::setAllocatedSlot(int slotID, SlotHandle handle) {
+    allocatedSlotID = slotID;
+    allocatedSlotHandle = handle;
+}
+
+void ParkingRequest::clearAllocatedSlot() {
+    allocatedSlotID = -1;
+    allocatedSlotHandle = SlotHandle();
+}
+
+IntrusiveListHook<ParkingRequest>& ParkingRequest::listHook() {
+    return activeHook;
+}
+
+bool ParkingRequest::isInActiveList() const {
+    return activeHook.linked;
+}
+
 void ParkingRequest::displayInfo() const {
     std::cout << "Vehicle ID: " << vehicleID << ", Zone: " << requestedZoneID 
               << ", Status: " << statusToString(currentStatus) 
@@ -1,7 +1,10 @@
 #include "ParkingSlot.h"
+#include "ParkingArea.h"
 #include <iostream>
 
-ParkingSlot::ParkingSlot(int id, int zone) : slotID(id), zoneID(zone), isAvailable(true) {}
+ParkingSlot::ParkingSlot(int id, int zone, SlotSize slotSize)
+    : slotID(id), zoneID(zone), state(FREE), size(slotSize), ownerArea(nullptr), indexInArea(-1),
+      zoneSlotIndex(-1) {}
 
 ParkingSlot::~ParkingSlot() {}
 
@@ -14,22 +17,59 @@ int ParkingSlot::getZoneID() const {
 }
 
 bool ParkingSlot::getIsAvailable() const { 
-    return isAvailable; 
+    return state.load() == FREE;
 }
 
-bool ParkingSlot::allocate() { 
-    if (isAvailable) {
-        isAvailable = false;
-        return true;
+SlotSize ParkingSlot::getSize() const {
+    return size;
+}
+
+SlotHandle ParkingSlot::getHandle() const {
+    return handle;
+}
+
+void ParkingSlot::setHandle(SlotHandle slotHandle) {
+    handle = slotHandle;
+}
+
+void ParkingSlot::attachToArea(ParkingArea* area, int index) {
+    ownerArea = area;
+    indexInArea = index;
+}
+
+int ParkingSlot::getZoneSlotIndex() const {
+    return zoneSlotIndex;
+}
+
+void ParkingSlot::setZoneSlotIndex(int index) {
+    zoneSlotIndex = index;
+}
+
+bool ParkingSlot::allocate() {
+    // Only the caller whose CAS leaves FREE owns the slot; a loser gets false
+    // and moves on to another candidate
+    int expected = FREE;
+    if (!state.compare_exchange_strong(expected, CLAIMING)) {
+        return false;
     }
-    return false;
+    if (ownerArea != nullptr) ownerArea->markSlotOccupied(indexInArea, size);
+    state.store(OCCUPIED);
+    return true;
 }
 
-void ParkingSlot::free() { 
-    isAvailable = true; 
+void ParkingSlot::free() {
+    int expected = OCCUPIED;
+    if (!state.compare_exchange_strong(expected, RELEASING)) {
+        return;
+    }
+    if (ownerArea != nullptr) ownerArea->markSlotAvailable(indexInArea, size);
+    state.store(FREE);
+    // Offered only now: a claimer that popped this slot while it was still
+    // RELEASING has given up on it, and must find it on the stack again
+    if (ownerArea != nullptr) ownerArea->offerFreeSlot(indexInArea);
 }
 
 void ParkingSlot::displayInfo() const {
     std::cout << "Slot ID: " << slotID << ", Zone: " << zoneID 
-              << ", Available: " << (isAvailable ? "Yes" : "No") << std::endl;
+              << ", Available: " << (getIsAvailable() ? "Yes" : "No") << std::endl;
 }
\ No newline at end of file
@@ -1,41 +1,53 @@
 #include "ParkingSystem.h"
 #include "ParkingArea.h"
 #include "ParkingSlot.h"
+#include "ReservationBook.h"
 #include "Zone.h"
 #include <iostream>
+#include <algorithm>
 #include <cstdint>
+#include <iterator>
+#include <limits>
+#include <numeric>
 #include <vector>
 
-ParkingSystem::ParkingSystem() {
+ParkingSystem::ParkingSystem(int rollbackHistoryDepth)
+    : nextReservationWakeup(std::numeric_limits<time_t>::max()), heldReservationCount(0),
+      verbose(true), analyticsPool(nullptr), publishAfterBatch(false), dashboardDirty(true), threadSafe(false) {
     engine = new AllocationEngine();
-    rollbackManager = new RollbackManager();
+    rollbackManager = new RollbackManager(rollbackHistoryDepth);
 }
 
 ParkingSystem::~ParkingSystem() {
     if (engine) delete engine;
     if (rollbackManager) delete rollbackManager;
+    delete analyticsPool;
 }
 
 void ParkingSystem::addZone(Zone* zone) {
+    std::unique_lock<std::shared_mutex> systemLock = lockExclusive();
     if (zone != nullptr) {
         engine->addZone(zone);
+        markDashboardDirty();
     }
 }
 
 bool ParkingSystem::createZone(int zoneID, int numSlots) {
-    // Check if zone already exists
-    auto zones = engine->getAllZones();
-    auto checkNode = zones.getHead();
-    while (checkNode != nullptr) {
-        if (checkNode->data != nullptr && checkNode->data->getZoneID() == zoneID) {
-            std::cerr << "❌ ERROR: Zone " << zoneID << " already exists!\n";
-            return false;
-        }
-        checkNode = checkNode->next;
+    return createZone(zoneID, 0, numSlots, 0);
+}
+
+bool ParkingSystem::createZone(int zoneID, int compactSlots, int standardSlots, int largeSlots) {
+    std::unique_lock<std::shared_mutex> systemLock = lockExclusive();
+    
+    // Check if zone already exists (O(1) zone table lookup)
+    if (engine->hasZone(zoneID)) {
+        std::cerr << "❌ ERROR: Zone " << zoneID << " already exists!\n";
+        return false;
     }
     
     // Validate input
-    if (numSlots <= 0) {
+    int numSlots = compactSlots + standardSlots + largeSlots;
+    if (compactSlots < 0 || standardSlots < 0 || largeSlots < 0 || numSlots <= 0) {
         std::cerr << "❌ ERROR: Number of slots must be greater than 0!\n";
         return false;
     }
@@ -44,22 +56,23 @@ bool ParkingSystem::createZone(int zoneID, int numSlots) {
         // Create new zone
         Zone* newZone = new Zone(zoneID);
         
-        // Create parking area and add slots
+        // Create parking area and add slots (numbered 1..N, smallest size class first)
         ParkingArea* area = new ParkingArea(1);  // Area ID 1 for simplicity
         for (int i = 1; i <= numSlots; i++) {
-            ParkingSlot* slot = new ParkingSlot(i, zoneID);
+            SlotSize size = (i <= compactSlots) ? SlotSize::COMPACT
+                          : (i <= compactSlots + standardSlots) ? SlotSize::STANDARD
+                          : SlotSize::LARGE;
+            ParkingSlot* slot = new ParkingSlot(i, zoneID, size);
             area->addSlot(slot);
         }
         newZone->addParkingArea(area);
         
-        // Refresh capacity to ensure accurate counts
-        newZone->refreshCapacity();
-        
         // Add to engine
         engine->addZone(newZone);
         
         // Store zone info for rollback
         zoneCreationHistory.insertBack(newZone);
+        markDashboardDirty();
         
         std::cout << "✅ Zone " << zoneID << " created successfully with " << numSlots << " slots\n";
         return true;
@@ -69,21 +82,32 @@ bool ParkingSystem::createZone(int zoneID, int numSlots) {
     }
 }
 
-ParkingRequest* ParkingSystem::createRequest(const std::string& vehicleID, int zoneID) {
+bool ParkingSystem::connectZones(int zoneA, int zoneB) {
+    std::unique_lock<std::shared_mutex> systemLock = lockExclusive();
+    if (!engine->connectZones(zoneA, zoneB)) {
+        return false;
+    }
+    markDashboardDirty();
+    std::cout << "✅ Zone " << zoneA << " and Zone " << zoneB << " are now adjacent\n";
+    return true;
+}
+
+ParkingRequest* ParkingSystem::createRequest(const std::string& vehicleID, int zoneID, VehicleType type) {
+    std::shared_lock<std::shared_mutex> systemLock = lockShared();
+    std::unique_lock<std::mutex> vehicleLock = lockVehicle(vehicleID);   // Check and insert as one step
+    
     // Check if vehicle already has an active request
-    auto currentNode = activeRequests.getHead();
-    while (currentNode != nullptr) {
-        if (currentNode->data != nullptr && currentNode->data->getVehicleID() == vehicleID) {
-            // Vehicle already has an active request
-            std::cerr << "❌ ERROR: Vehicle " << vehicleID << " already has an active request!\n";
-            return nullptr;
-        }
-        currentNode = currentNode->next;
+    if (findRequestByVehicleID(vehicleID) != nullptr) {
+        std::cerr << "❌ ERROR: Vehicle " << vehicleID << " already has an active request!\n";
+        return nullptr;
     }
     
-    ParkingRequest* req = new ParkingRequest(vehicleID, zoneID);
-    activeRequests.insertBack(req);
-    masterHistoryList.insertBack(req);
+    ParkingRequest* req = new ParkingRequest(vehicleID, zoneID, type);
+    activateRequest(req);
+    {
+        std::unique_lock<std::mutex> registryLock = lockRegistry();
+        masterHistoryList.insertBack(req);
+    }
     
     // Get the zone for the command
     Zone* zone = getZoneByID(zoneID);
@@ -91,312 +115,574 @@ ParkingRequest* ParkingSystem::createRequest(const std::string& vehicleID, int z
     // Record the creation as a command for rollback
     // oldState is REQUESTED, newState is also REQUESTED (just created)
     // This allows us to identify creation operations during rollback
-    Command createCmd;
-    createCmd.requestPtr = req;
-    createCmd.slotPtr = nullptr;
-    createCmd.zonePtr = zone;
-    createCmd.oldState = RequestState::REQUESTED;  // Marker for "before creation"
-    createCmd.newState = RequestState::REQUESTED;  // Just created
-    rollbackManager->recordCommand(createCmd);
-    
-    std::cout << "✅ Request created for Vehicle " << vehicleID << " in Zone " << zoneID << "\n";
+    recordCommand(req, nullptr, zone,
+                  RequestState::REQUESTED,   // Marker for "before creation"
+                  RequestState::REQUESTED);  // Just created
+    
+    if (verbose) {
+        std::cout << "✅ Request created for Vehicle " << vehicleID << " in Zone " << zoneID << "\n";
+    }
     return req;
 }
 
 bool ParkingSystem::allocateSlotForRequest(const std::string& vehicleID) {
+    std::shared_lock<std::shared_mutex> systemLock = lockShared();
+    std::unique_lock<std::mutex> vehicleLock = lockVehicle(vehicleID);
+    
     // Find the request for this vehicle
-    auto currentNode = activeRequests.getHead();
-    while (currentNode != nullptr) {
-        if (currentNode->data != nullptr && currentNode->data->getVehicleID() == vehicleID) {
-            ParkingRequest* request = currentNode->data;
+    ParkingRequest* request = findRequestByVehicleID(vehicleID);
+    if (request == nullptr) {
+        std::cerr << "❌ ERROR: Vehicle " << vehicleID << " not found in system!\n";
+        return false;
+    }
+    
+    // Check if request is in REQUESTED state (not already allocated)
+    if (request->getCurrentStatus() != RequestState::REQUESTED) {
+        std::cerr << "❌ ERROR: Vehicle " << vehicleID << " request is not in REQUESTED state!\n";
+        std::cerr << "   Current status: " << request->statusToString(request->getCurrentStatus()) << "\n";
+        return false;
+    }
+    
+    // A slot held by a reservation is handed over before any search; held
+    // slots already count as occupied, so this must precede the full check
+    activateDueReservations(std::time(nullptr));
+    ParkingSlot* reservedSlot = claimReservedSlot(request);
+    if (reservedSlot != nullptr) {
+        recordCommand(request, reservedSlot, getZoneByID(reservedSlot->getZoneID()),
+                      RequestState::REQUESTED, RequestState::ALLOCATED);
+        if (verbose) {
+            std::cout << "✅ Reserved slot " << reservedSlot->getSlotID() << " allocated for Vehicle " << vehicleID << "\n";
+        }
+        return true;
+    }
+    
+    // Fast fail before any search when the whole facility is full (O(1))
+    if (engine->isFacilityFull()) {
+        std::cerr << "❌ ERROR: Facility is full - no parking slots available for Vehicle " << vehicleID << "\n";
+        return false;
+    }
+    
+    // The request already carries the zone and vehicle type, so the engine
+    // gets it directly - no temporary Vehicle (and no copy of its ID string)
+    ParkingSlot* allocatedSlot = engine->allocateSlotInZone(engine->findZoneByID(request->getRequestedZoneID()), request);
+    
+    if (allocatedSlot == nullptr) {
+        std::cerr << "❌ ERROR: No parking slots available for Vehicle " << vehicleID << "\n";
+        return false;
+    }
+    
+    // Get the zone the slot actually came from (may differ after cross-zone overflow)
+    Zone* zone = getZoneByID(allocatedSlot->getZoneID());
+    
+    // Record command for rollback
+    recordCommand(request, allocatedSlot, zone, RequestState::REQUESTED, RequestState::ALLOCATED);
+    
+    if (verbose) {
+        std::cout << "✅ Slot allocated for Vehicle " << vehicleID << "\n";
+    }
+    return true;
+}
+
+std::vector<BatchAllocationResult> ParkingSystem::allocateBatch(const std::vector<BatchArrival>& arrivals) {
+    std::unique_lock<std::shared_mutex> systemLock = lockExclusive();   // Keeps the batch one contiguous rollback unit
+    std::vector<BatchAllocationResult> results(arrivals.size());
+    
+    // Drop duplicates in arrival order first, so the earliest arrival of a
+    // vehicle listed twice is the one that gets a request
+    std::vector<int> order;
+    order.reserve(arrivals.size());
+    HashIndex<std::string, bool> batchVehicles;
+    for (size_t i = 0; i < arrivals.size(); i++) {
+        results[i].vehicleID = arrivals[i].vehicleID;
+        if (findRequestByVehicleID(arrivals[i].vehicleID) != nullptr ||
+            !batchVehicles.insert(arrivals[i].vehicleID, true)) {
+            continue;
+        }
+        order.push_back((int)i);
+    }
+    
+    // Group arrivals by preferred zone (stable, so arrival order is kept within a zone)
+    std::stable_sort(order.begin(), order.end(), [&arrivals](int a, int b) {
+        return arrivals[a].zoneID < arrivals[b].zoneID;
+    });
+    
+    activateDueReservations(std::time(nullptr));
+    bool engineVerbose = engine->isVerbose();
+    engine->setVerbose(false);
+    rollbackManager->beginGroup();
+    
+    int allocatedCount = 0;
+    size_t next = 0;
+    while (next < order.size()) {
+        int zoneID = arrivals[order[next]].zoneID;
+        Zone* zone = engine->findZoneByID(zoneID);   // Once per zone group
+        
+        for (; next < order.size() && arrivals[order[next]].zoneID == zoneID; next++) {
+            int index = order[next];
+            const BatchArrival& arrival = arrivals[index];
+            BatchAllocationResult& result = results[index];
             
-            // Check if request is in REQUESTED state (not already allocated)
-            if (request->getCurrentStatus() != RequestState::REQUESTED) {
-                std::cerr << "❌ ERROR: Vehicle " << vehicleID << " request is not in REQUESTED state!\n";
-                std::cerr << "   Current status: " << request->statusToString(request->getCurrentStatus()) << "\n";
-                return false;
-            }
+            ParkingRequest* request = new ParkingRequest(arrival.vehicleID, zoneID, arrival.vehicleType);
+            activateRequest(request);
+            masterHistoryList.insertBack(request);
+            recordCommand(request, nullptr, zone, RequestState::REQUESTED, RequestState::REQUESTED);
             
-            // Create a temporary vehicle object for allocation engine
-            // Note: We need the preferred zone ID from the request
-            Vehicle tempVehicle(vehicleID, request->getRequestedZoneID());
+            ParkingSlot* slot = claimReservedSlot(request);
+            if (slot == nullptr) {
+                slot = engine->allocateSlotInZone(zone, request);
+            }
+            if (slot == nullptr) {
+                continue;
+            }
             
-            // Call allocation engine to find an available slot
-            ParkingSlot* allocatedSlot = engine->allocateSlot(&tempVehicle, request);
+            Zone* slotZone = (slot->getZoneID() == zoneID) ? zone : engine->findZoneByID(slot->getZoneID());
+            recordCommand(request, slot, slotZone, RequestState::REQUESTED, RequestState::ALLOCATED);
             
-            if (allocatedSlot != nullptr) {
-                // Get the zone for the command
-                Zone* zone = getZoneByID(request->getRequestedZoneID());
-                
-                // Record command for rollback
-                Command cmd;
-                cmd.requestPtr = request;
-                cmd.slotPtr = allocatedSlot;
-                cmd.zonePtr = zone;
-                cmd.oldState = RequestState::REQUESTED;
-                cmd.newState = RequestState::ALLOCATED;
-                rollbackManager->recordCommand(cmd);
-                
-                std::cout << "✅ Slot allocated for Vehicle " << vehicleID << "\n";
-                return true;
-            } else {
-                std::cerr << "❌ ERROR: No parking slots available for Vehicle " << vehicleID << "\n";
-                return false;
+            result.allocated = true;
+            result.zoneID = slot->getZoneID();
+            result.slotID = slot->getSlotID();
+            result.penaltyCost = request->getPenaltyCost();
+            allocatedCount++;
+        }
+    }
+    
+    rollbackManager->endGroup();
+    engine->setVerbose(engineVerbose);
+    
+    if (verbose) {
+        std::cout << "✅ Batch allocation: " << allocatedCount << " of " << arrivals.size()
+                  << " vehicles allocated\n";
+    }
+    
+    // The batch is the publish boundary; build the snapshot after the
+    // exclusive lock is gone so other writers are not held up by it
+    if (publishAfterBatch.load()) {
+        if (systemLock.owns_lock()) systemLock.unlock();
+        publishIfChanged();
+    }
+    return results;
+}
+
+void ParkingSystem::setVerbose(bool enabled) {
+    std::unique_lock<std::shared_mutex> systemLock = lockExclusive();
+    verbose = enabled;
+    engine->setVerbose(enabled);
+}
+
+void ParkingSystem::setAllocationPolicy(AllocationPolicyType type) {
+    std::unique_lock<std::shared_mutex> systemLock = lockExclusive();
+    engine->setAllocationPolicy(type);
+}
+
+void ParkingSystem::setThreadSafe(bool enabled) {
+    threadSafe = enabled;
+    engine->setThreadSafe(enabled);
+}
+
+void ParkingSystem::setPublishAfterBatch(bool enabled) {
+    publishAfterBatch.store(enabled);
+}
+
+void ParkingSystem::setAnalyticsThreads(int threadCount) {
+    std::unique_lock<std::shared_mutex> systemLock = lockExclusive();
+    delete analyticsPool;
+    analyticsPool = (threadCount > 0) ? new WorkStealingPool(threadCount) : nullptr;
+}
+
+// ============================================================================
+// RESERVATIONS
+// ============================================================================
+
+int ParkingSystem::reserveSlot(const std::string& vehicleID, int zoneID, time_t start, time_t end,
+                               VehicleType type) {
+    std::unique_lock<std::shared_mutex> systemLock = lockExclusive();
+    Zone* zone = getZoneByID(zoneID);
+    if (zone == nullptr) {
+        std::cerr << "❌ ERROR: Zone " << zoneID << " does not exist!\n";
+        return -1;
+    }
+    if (start >= end) {
+        std::cerr << "❌ ERROR: Reservation window for Vehicle " << vehicleID << " is empty!\n";
+        return -1;
+    }
+    
+    int reservationID = zone->getReservationBook()->reserve(vehicleID, start, end, requiredSlotSize(type));
+    if (reservationID == -1) {
+        std::cerr << "❌ ERROR: No slot in Zone " << zoneID << " is free for the requested window (Vehicle "
+                  << vehicleID << ")\n";
+        return -1;
+    }
+    {
+        std::unique_lock<std::mutex> reservationLock = lockReservations();
+        scheduleReservationWakeup(zone);
+    }
+    markDashboardDirty();
+    
+    if (verbose) {
+        std::cout << "✅ Reservation " << reservationID << " created for Vehicle " << vehicleID
+                  << " in Zone " << zoneID << "\n";
+    }
+    return reservationID;
+}
+
+bool ParkingSystem::cancelReservation(int zoneID, int reservationID) {
+    std::unique_lock<std::shared_mutex> systemLock = lockExclusive();
+    Zone* zone = getZoneByID(zoneID);
+    const Reservation* reservation = (zone != nullptr && zone->hasReservationBook())
+                                     ? zone->getReservationBook()->getReservation(reservationID) : nullptr;
+    if (reservation == nullptr) {
+        std::cerr << "❌ ERROR: Reservation " << reservationID << " not found in Zone " << zoneID << "!\n";
+        return false;
+    }
+    
+    // A held slot goes back to the zone, so forget where the vehicle's hold was
+    if (reservation->held) {
+        std::unique_lock<std::mutex> reservationLock = lockReservations();
+        typedef std::unordered_multimap<std::string, Zone*>::iterator HeldIterator;
+        std::pair<HeldIterator, HeldIterator> range = heldReservationZones.equal_range(reservation->vehicleID);
+        for (HeldIterator it = range.first; it != range.second; ++it) {
+            if (it->second == zone) {
+                heldReservationZones.erase(it);
+                break;
             }
         }
-        currentNode = currentNode->next;
+        heldReservationCount.store((int)heldReservationZones.size());
+    }
+    zone->getReservationBook()->cancel(reservationID);
+    markDashboardDirty();
+    return true;
+}
+
+void ParkingSystem::activateReservations(time_t now) {
+    std::shared_lock<std::shared_mutex> systemLock = lockShared();
+    activateDueReservations(now);
+}
+
+void ParkingSystem::activateDueReservations(time_t now) {
+    // Nothing starts or ends before the earliest wakeup: O(1) on almost every
+    // allocation. Only reserveSlot() (exclusive lock) moves the wakeup earlier,
+    // so a stale read here can only send us down the slow path needlessly.
+    if (now < nextReservationWakeup.load()) return;
+    
+    std::unique_lock<std::mutex> reservationLock = lockReservations();
+    std::vector<Zone*> dueZones;
+    while (!reservationWakeups.empty() && reservationWakeups.top().first <= now) {
+        dueZones.push_back(reservationWakeups.top().second);
+        reservationWakeups.pop();
     }
+    std::sort(dueZones.begin(), dueZones.end());
+    dueZones.erase(std::unique(dueZones.begin(), dueZones.end()), dueZones.end());
     
-    std::cerr << "❌ ERROR: Vehicle " << vehicleID << " not found in system!\n";
-    return false;
+    std::vector<std::string> heldVehicles;
+    std::vector<std::string> releasedVehicles;
+    for (Zone* zone : dueZones) {
+        heldVehicles.clear();
+        releasedVehicles.clear();
+        {
+            std::unique_lock<std::mutex> zoneLock = engine->lockZone(zone);   // Holds allocate slots
+            zone->getReservationBook()->activateDue(now, heldVehicles, releasedVehicles);
+        }
+        for (const std::string& vehicleID : heldVehicles) {
+            heldReservationZones.insert(std::make_pair(vehicleID, zone));
+        }
+        typedef std::unordered_multimap<std::string, Zone*>::iterator HeldIterator;
+        for (const std::string& vehicleID : releasedVehicles) {
+            std::pair<HeldIterator, HeldIterator> range = heldReservationZones.equal_range(vehicleID);
+            for (HeldIterator it = range.first; it != range.second; ++it) {
+                if (it->second == zone) {
+                    heldReservationZones.erase(it);
+                    break;
+                }
+            }
+        }
+        scheduleReservationWakeup(zone);
+    }
+    heldReservationCount.store((int)heldReservationZones.size());
+    if (!dueZones.empty()) markDashboardDirty();   // Holds and expiries change free slots
+    nextReservationWakeup.store(reservationWakeups.empty() ? std::numeric_limits<time_t>::max()
+                                                           : reservationWakeups.top().first);
 }
 
-bool ParkingSystem::occupyRequest(const std::string& vehicleID) {
-    // Find the request for this vehicle
-    auto currentNode = activeRequests.getHead();
-    while (currentNode != nullptr) {
-        if (currentNode->data != nullptr && currentNode->data->getVehicleID() == vehicleID) {
-            ParkingRequest* request = currentNode->data;
-            
-            // Check if vehicle is in ALLOCATED state (can occupy)
-            if (request->getCurrentStatus() != RequestState::ALLOCATED) {
-                std::cerr << "❌ ERROR: Vehicle " << vehicleID << " does not have an allocated slot!\n";
-                std::cerr << "   Current status: " << request->statusToString(request->getCurrentStatus()) << "\n";
-                return false;
+void ParkingSystem::scheduleReservationWakeup(Zone* zone) {
+    time_t next = zone->getReservationBook()->getNextEventTime();
+    if (next == std::numeric_limits<time_t>::max()) return;
+    reservationWakeups.push(ReservationWakeup(next, zone));
+    if (next < nextReservationWakeup.load()) nextReservationWakeup.store(next);
+}
+
+// Hands the request a slot its vehicle's reservation is holding, marking it
+// ALLOCATED; nullptr if there is none. A hold in the requested zone is
+// preferred, but one in any other zone is honoured too.
+ParkingSlot* ParkingSystem::claimReservedSlot(ParkingRequest* request) {
+    if (heldReservationCount.load() == 0) return nullptr;   // Common case, no lock
+    
+    std::unique_lock<std::mutex> reservationLock = lockReservations();
+    const std::string& vehicleID = request->getVehicleID();
+    typedef std::unordered_multimap<std::string, Zone*>::iterator HeldIterator;
+    ParkingSlot* reservedSlot = nullptr;
+    while (reservedSlot == nullptr) {
+        std::pair<HeldIterator, HeldIterator> range = heldReservationZones.equal_range(vehicleID);
+        if (range.first == range.second) break;
+        
+        HeldIterator chosen = range.first;
+        for (HeldIterator it = range.first; it != range.second; ++it) {
+            if (it->second->getZoneID() == request->getRequestedZoneID()) {
+                chosen = it;
+                break;
             }
-            
-            // Record command for rollback
-            // Get the zone for the command (need to get the slot from the request somehow)
-            Zone* zone = getZoneByID(request->getRequestedZoneID());
-            Command cmd;
-            cmd.requestPtr = request;
-            cmd.slotPtr = nullptr;  // No slot change during occupy
-            cmd.zonePtr = zone;
-            cmd.oldState = RequestState::ALLOCATED;
-            cmd.newState = RequestState::OCCUPIED;
-            rollbackManager->recordCommand(cmd);
-            
-            // Transition to OCCUPIED state
-            request->updateState(RequestState::OCCUPIED);
-            std::cout << "✅ Vehicle " << vehicleID << " is now occupying the slot\n";
-            return true;
         }
-        currentNode = currentNode->next;
+        Zone* zone = chosen->second;
+        heldReservationZones.erase(chosen);
+        std::unique_lock<std::mutex> zoneLock = engine->lockZone(zone);
+        reservedSlot = zone->getReservationBook()->claimHeldSlot(vehicleID);
     }
+    heldReservationCount.store((int)heldReservationZones.size());
     
-    std::cerr << "❌ ERROR: Vehicle " << vehicleID << " not found in system!\n";
-    return false;
+    if (reservedSlot != nullptr) {
+        request->setAllocatedSlot(reservedSlot->getSlotID(), reservedSlot->getHandle());
+        request->updateState(RequestState::ALLOCATED);
+    }
+    return reservedSlot;
+}
+
+bool ParkingSystem::occupyRequest(const std::string& vehicleID) {
+    std::shared_lock<std::shared_mutex> systemLock = lockShared();
+    std::unique_lock<std::mutex> vehicleLock = lockVehicle(vehicleID);
+    
+    // Find the request for this vehicle
+    ParkingRequest* request = findRequestByVehicleID(vehicleID);
+    if (request == nullptr) {
+        std::cerr << "❌ ERROR: Vehicle " << vehicleID << " not found in system!\n";
+        return false;
+    }
+    
+    // Check if vehicle is in ALLOCATED state (can occupy)
+    if (request->getCurrentStatus() != RequestState::ALLOCATED) {
+        std::cerr << "❌ ERROR: Vehicle " << vehicleID << " does not have an allocated slot!\n";
+        std::cerr << "   Current status: " << request->statusToString(request->getCurrentStatus()) << "\n";
+        return false;
+    }
+    
+    // Record command for rollback
+    // Get the zone for the command (need to get the slot from the request somehow)
+    Zone* zone = getZoneByID(request->getRequestedZoneID());
+    // No slot change during occupy
+    recordCommand(request, nullptr, zone, RequestState::ALLOCATED, RequestState::OCCUPIED);
+    
+    // Transition to OCCUPIED state
+    request->updateState(RequestState::OCCUPIED);
+    if (verbose) {
+        std::cout << "✅ Vehicle " << vehicleID << " is now occupying the slot\n";
+    }
+    return true;
 }
 
 bool ParkingSystem::releaseRequest(const std::string& vehicleID) {
+    std::shared_lock<std::shared_mutex> systemLock = lockShared();
+    std::unique_lock<std::mutex> vehicleLock = lockVehicle(vehicleID);
+    
     // Find the request for this vehicle
-    auto currentNode = activeRequests.getHead();
-    while (currentNode != nullptr) {
-        if (currentNode->data != nullptr && currentNode->data->getVehicleID() == vehicleID) {
-            ParkingRequest* request = currentNode->data;
-            
-            // Check if vehicle is actually occupying a slot (OCCUPIED state)
-            if (request->getCurrentStatus() != RequestState::OCCUPIED) {
-                std::cerr << "❌ ERROR: Vehicle " << vehicleID << " is not currently occupying a slot!\n";
-                std::cerr << "   Current status: " << request->statusToString(request->getCurrentStatus()) << "\n";
-                return false;
-            }
-            
-            // Get allocated slot before freeing (for rollback)
-            int slotID = request->getAllocatedSlotID();
-            RequestState oldState = request->getCurrentStatus();
-            if (slotID != -1) {
-                engine->freeSlot(slotID);
-            }
-            
-            // Record command for rollback
-            Command cmd;
-            cmd.requestPtr = request;
-            cmd.slotPtr = nullptr;
-            cmd.oldState = oldState;
-            cmd.newState = RequestState::RELEASED;
-            rollbackManager->recordCommand(cmd);
-            
-            // Update the request status to RELEASED
-            request->updateState(RequestState::RELEASED);
-            
-            // Remove from active requests since it's released
-            auto nodeToRemove = currentNode;
-            currentNode = currentNode->next;  // Move to next before deletion
-            activeRequests.removeNode(nodeToRemove);
-            
-            std::cout << "✅ Vehicle " << vehicleID << " has released parking slot " << slotID << "\n";
-            return true;
-        }
-        currentNode = currentNode->next;
+    ParkingRequest* request = findRequestByVehicleID(vehicleID);
+    if (request == nullptr) {
+        std::cerr << "❌ ERROR: Vehicle " << vehicleID << " not found in system!\n";
+        return false;
+    }
+    
+    // Check if vehicle is actually occupying a slot (OCCUPIED state)
+    if (request->getCurrentStatus() != RequestState::OCCUPIED) {
+        std::cerr << "❌ ERROR: Vehicle " << vehicleID << " is not currently occupying a slot!\n";
+        std::cerr << "   Current status: " << request->statusToString(request->getCurrentStatus()) << "\n";
+        return false;
     }
     
-    std::cerr << "❌ ERROR: Vehicle " << vehicleID << " not found in system!\n";
-    return false;
+    // Get allocated slot before freeing (for rollback)
+    int slotID = request->getAllocatedSlotID();
+    RequestState oldState = request->getCurrentStatus();
+    ParkingSlot* slot = engine->resolveSlot(request->getAllocatedSlotHandle());
+    Zone* zone = nullptr;
+    if (slot != nullptr) {
+        zone = getZoneByID(slot->getZoneID());
+        engine->freeSlot(request->getAllocatedSlotHandle());
+    }
+    
+    // Record command for rollback (slot and zone let rollback re-occupy the exact slot)
+    recordCommand(request, slot, zone, oldState, RequestState::RELEASED);
+    
+    // Update the request status to RELEASED
+    request->updateState(RequestState::RELEASED);
+    
+    // Remove from active requests since it's released
+    deactivateRequest(request);
+    
+    if (verbose) {
+        std::cout << "✅ Vehicle " << vehicleID << " has released parking slot " << slotID << "\n";
+    }
+    return true;
 }
 
 bool ParkingSystem::cancelRequest(const std::string& vehicleID) {
+    std::shared_lock<std::shared_mutex> systemLock = lockShared();
+    std::unique_lock<std::mutex> vehicleLock = lockVehicle(vehicleID);
+    
     // Find the request for this vehicle
-    auto currentNode = activeRequests.getHead();
-    while (currentNode != nullptr) {
-        if (currentNode->data != nullptr && currentNode->data->getVehicleID() == vehicleID) {
-            ParkingRequest* request = currentNode->data;
-            
-            // Check if request is not already RELEASED or CANCELLED
-            RequestState currentStatus = request->getCurrentStatus();
-            if (currentStatus == RequestState::RELEASED || currentStatus == RequestState::CANCELLED) {
-                std::cerr << "❌ ERROR: Vehicle " << vehicleID << " request has already been cancelled or released!\n";
-                std::cerr << "   Current status: " << request->statusToString(currentStatus) << "\n";
-                return false;
-            }
-            
-            // Get allocated slot before freeing (for rollback)
-            int slotID = request->getAllocatedSlotID();
-            RequestState oldState = currentStatus;
-            if (slotID != -1) {
-                engine->freeSlot(slotID);
-            }
-            
-            // Record command for rollback
-            Command cmd;
-            cmd.requestPtr = request;
-            cmd.slotPtr = nullptr;
-            cmd.oldState = oldState;
-            cmd.newState = RequestState::CANCELLED;
-            rollbackManager->recordCommand(cmd);
-            
-            // Update the request status to CANCELLED
-            request->updateState(RequestState::CANCELLED);
-            
-            // Remove from active requests - vehicle is out of the system
-            auto nodeToRemove = currentNode;
-            currentNode = currentNode->next;  // Move to next before deletion
-            activeRequests.removeNode(nodeToRemove);
-            
-            std::cout << "✅ Vehicle " << vehicleID << " request cancelled and removed from system\n";
-            return true;
-        }
-        currentNode = currentNode->next;
+    ParkingRequest* request = findRequestByVehicleID(vehicleID);
+    if (request == nullptr) {
+        std::cerr << "❌ ERROR: Vehicle " << vehicleID << " not found in system!\n";
+        return false;
     }
     
-    std::cerr << "❌ ERROR: Vehicle " << vehicleID << " not found in system!\n";
-    return false;
+    // Check if request is not already RELEASED or CANCELLED
+    RequestState currentStatus = request->getCurrentStatus();
+    if (currentStatus == RequestState::RELEASED || currentStatus == RequestState::CANCELLED) {
+        std::cerr << "❌ ERROR: Vehicle " << vehicleID << " request has already been cancelled or released!\n";
+        std::cerr << "   Current status: " << request->statusToString(currentStatus) << "\n";
+        return false;
+    }
+    
+    // Get allocated slot before freeing (for rollback)
+    RequestState oldState = currentStatus;
+    ParkingSlot* slot = engine->resolveSlot(request->getAllocatedSlotHandle());
+    Zone* zone = nullptr;
+    if (slot != nullptr) {
+        zone = getZoneByID(slot->getZoneID());
+        engine->freeSlot(request->getAllocatedSlotHandle());
+    }
+    
+    // Record command for rollback (slot and zone let rollback re-occupy the exact slot)
+    recordCommand(request, slot, zone, oldState, RequestState::CANCELLED);
+    
+    // Update the request status to CANCELLED
+    request->updateState(RequestState::CANCELLED);
+    
+    // Remove from active requests - vehicle is out of the system
+    deactivateRequest(request);
+    
+    if (verbose) {
+        std::cout << "✅ Vehicle " << vehicleID << " request cancelled and removed from system\n";
+    }
+    return true;
 }
 
 DashboardStats ParkingSystem::getDashboardStats() const {
+    // Shared: request states and zone counters are atomics, and the history
+    // walk holds the registry lock against concurrent inserts
+    std::shared_lock<std::shared_mutex> systemLock = lockShared();
+    return computeDashboardStats();
+}
+
+uint64_t ParkingSystem::publishDashboard() {
+    std::lock_guard<std::mutex> publishLock(publishMutex);
+    // Cleared before computing: a mutation that lands during the scan marks
+    // the dashboard dirty again, so the next publish picks it up
+    dashboardDirty.store(false);
+    std::shared_lock<std::shared_mutex> systemLock = lockShared();
+    return dashboardPublisher.publish(computeDashboardStats());
+}
+
+uint64_t ParkingSystem::publishIfChanged() {
+    if (!dashboardDirty.load()) return 0;   // Common case, no lock
+    return publishDashboard();
+}
+
+DashboardSnapshot ParkingSystem::getPublishedDashboard() const {
+    return dashboardPublisher.acquire();   // No system lock: never waits for writers
+}
+
+DashboardStats ParkingSystem::computeDashboardStats() const {
     DashboardStats stats;
     
     try {
+        std::unique_lock<std::mutex> registryLock = lockRegistry();   // createRequest() may append to the history
+        
         // Count total requests from master history (excluding cancelled from active counts)
         stats.totalRequests = masterHistoryList.getSize();
         stats.requestsAllocated = 0;
         stats.requestsOccupied = 0;
         stats.requestsReleased = 0;
         stats.requestsCancelled = 0;
+        stats.mostAvailableZoneID = -1;
+        stats.mostAvailableZoneSlots = 0;
         
-        // Count requests by status - only count active (non-cancelled) vehicles
-        auto reqNode = masterHistoryList.getHead();
-        while (reqNode != nullptr) {
-            if (reqNode->data != nullptr) {
-                ParkingRequest* req = reqNode->data;
-                RequestState status = req->getCurrentStatus();
-                
-                // Only count active vehicles (not cancelled or released)
-                if (status == RequestState::ALLOCATED) {
-                    stats.requestsAllocated++;
-                } else if (status == RequestState::OCCUPIED) {
-                    stats.requestsOccupied++;
-                } else if (status == RequestState::RELEASED) {
-                    stats.requestsReleased++;
-                } else if (status == RequestState::CANCELLED) {
-                    stats.requestsCancelled++;
+        // Count requests by status, one chunk of history slots per task.
+        // Chunks are summed in chunk order below, so the totals never depend
+        // on how the pool scheduled them
+        struct StatusCounts {
+            int allocated = 0;
+            int occupied = 0;
+            int released = 0;
+            int cancelled = 0;
+        };
+        uint32_t historySlots = masterHistoryList.getSlotCount();
+        int historyChunks = (int)((historySlots + HISTORY_SLOTS_PER_CHUNK - 1) / HISTORY_SLOTS_PER_CHUNK);
+        std::vector<StatusCounts> chunkCounts(historyChunks);
+        runChunks(historyChunks, [this, &chunkCounts](int chunk) {
+            StatusCounts counts;   // Local, so neighbouring chunks do not share a cache line while counting
+            uint32_t begin = (uint32_t)chunk * HISTORY_SLOTS_PER_CHUNK;
+            masterHistoryList.forEachInSlotRange(begin, begin + HISTORY_SLOTS_PER_CHUNK, [&counts](ParkingRequest* req) {
+                if (req == nullptr) return;
+                switch (req->getCurrentStatus()) {
+                    case RequestState::ALLOCATED: counts.allocated++; break;
+                    case RequestState::OCCUPIED:  counts.occupied++;  break;
+                    case RequestState::RELEASED:  counts.released++;  break;
+                    case RequestState::CANCELLED: counts.cancelled++; break;
+                    default: break;
                 }
-            }
-            reqNode = reqNode->next;
+            });
+            chunkCounts[chunk] = counts;
+        });
+        for (const StatusCounts& counts : chunkCounts) {
+            stats.requestsAllocated += counts.allocated;
+            stats.requestsOccupied += counts.occupied;
+            stats.requestsReleased += counts.released;
+            stats.requestsCancelled += counts.cancelled;
         }
+        if (registryLock.owns_lock()) registryLock.unlock();
         
         stats.averageParkingDuration = calculateAverageDuration();
         
         // Get zones list and immediately collect zone pointers to avoid pointer corruption
-        const DoublyLinkedList<Zone*>& zonesList = engine->getAllZones();
+        const SlotMap<Zone*>& zonesList = engine->getAllZones();
         stats.totalZones = zonesList.getSize();
         
-        // Create a safe copy of zone pointers first
+        // Copy zone pointers into a contiguous array so the per-zone work
+        // can be split into chunks
         std::vector<Zone*> zonePtrs;
-        auto tempNode = zonesList.getHead();
-        int tempCount = 0;
+        zonePtrs.reserve(zonesList.getSize());
+        std::copy_if(zonesList.begin(), zonesList.end(), std::back_inserter(zonePtrs),
+                     [](Zone* zone) { return zone != nullptr; });
         
-        while (tempNode != nullptr && tempCount < 10000) {
-            // Validate tempNode pointer
-            if ((intptr_t)tempNode < 0x1000 || (intptr_t)tempNode > 0x7FFFFFFF0000) {
-                break;
-            }
+        // Compute each zone's status independently; zoneID -1 marks zones
+        // that failed validation
+        std::vector<ZoneSlotStatus> zoneResults(zonePtrs.size());
+        auto computeZoneStatus = [](Zone* zone) {
+            int zoneID = zone->getZoneID();
+            int zoneTotalSlots = zone->getTotalCapacity();
+            int zoneAvailableSlots = zone->getAvailableSlots();
             
-            if (tempNode->data != nullptr) {
-                // Double-check the data pointer
-                if ((intptr_t)(tempNode->data) >= 0x1000 && (intptr_t)(tempNode->data) <= 0x7FFFFFFF0000) {
-                    zonePtrs.push_back(tempNode->data);
-                }
+            // Check that the zone values are reasonable
+            if (zoneID < 1 || zoneID > 999 ||
+                zoneTotalSlots <= 0 || zoneTotalSlots > 100000 ||
+                zoneAvailableSlots < 0 || zoneAvailableSlots > zoneTotalSlots) {
+                return ZoneSlotStatus(-1, 0, 0);
             }
-            
-            // Get next pointer safely
-            auto nextPtr = tempNode->next;
-            tempNode = nextPtr;
-            tempCount++;
-        }
+            return ZoneSlotStatus(zoneID, zoneTotalSlots, zoneAvailableSlots);
+        };
+        int zoneChunks = ((int)zonePtrs.size() + ZONES_PER_CHUNK - 1) / ZONES_PER_CHUNK;
+        runChunks(zoneChunks, [&zonePtrs, &zoneResults, &computeZoneStatus](int chunk) {
+            size_t begin = (size_t)chunk * ZONES_PER_CHUNK;
+            size_t end = std::min(begin + ZONES_PER_CHUNK, zonePtrs.size());
+            std::transform(zonePtrs.begin() + begin, zonePtrs.begin() + end, zoneResults.begin() + begin,
+                           computeZoneStatus);
+        });
         
-        // Now process the copied pointers (safer approach)
+        // Reduce in zone order so the result is deterministic
         int totalSlots = 0;
         int occupiedSlots = 0;
-        
-        for (size_t i = 0; i < zonePtrs.size() && i < 10000; ++i) {
-            Zone* zone = zonePtrs[i];
-            
-            try {
-                // Check zone pointer validity
-                if ((intptr_t)zone < 0x1000 || (intptr_t)zone > 0x7FFFFFFF0000) {
-                    continue;
-                }
-                
-                int zoneID = zone->getZoneID();
-                
-                // Check if zoneID is reasonable
-                if (zoneID < 1 || zoneID > 999) {
-                    continue;
-                }
-                
-                int zoneTotalSlots = zone->getTotalCapacity();
-                
-                if (zoneTotalSlots <= 0 || zoneTotalSlots > 100000) {
-                    continue;
-                }
-                
-                int zoneAvailableSlots = zone->getAvailableSlots();
-                
-                if (zoneAvailableSlots < 0 || zoneAvailableSlots > zoneTotalSlots) {
-                    continue;
-                }
-                
-                int zoneOccupiedSlots = zoneTotalSlots - zoneAvailableSlots;
-                
-                totalSlots += zoneTotalSlots;
-                occupiedSlots += zoneOccupiedSlots;
-                
-                // Create zone status
-                ZoneSlotStatus zoneStatus;
-                zoneStatus.zoneID = zoneID;
-                zoneStatus.totalSlots = zoneTotalSlots;
-                zoneStatus.availableSlots = zoneAvailableSlots;
-                zoneStatus.occupiedSlots = zoneOccupiedSlots;
-                zoneStatus.utilization = (zoneTotalSlots > 0) ? 
-                    (100.0 * zoneOccupiedSlots / zoneTotalSlots) : 0.0;
-                
-                stats.zoneStatuses.insertBack(zoneStatus);
-            } catch (const std::exception& e) {
-                std::cerr << "Exception processing zone: " << e.what() << "\n";
-            } catch (...) {
-                std::cerr << "Unknown exception processing zone\n";
-            }
+        for (ZoneSlotStatus& zoneStatus : zoneResults) {
+            if (zoneStatus.zoneID == -1) continue;
+            totalSlots += zoneStatus.totalSlots;
+            occupiedSlots += zoneStatus.occupiedSlots;
+            stats.zoneStatuses.insertBack(std::move(zoneStatus));
         }
         
         // Set actual occupied slots from zones (cancelled vehicles have freed their slots)
@@ -405,6 +691,13 @@ DashboardStats ParkingSystem::getDashboardStats() const {
         // Calculate overall system utilization
         stats.systemUtilization = (totalSlots > 0) ? (100.0 * occupiedSlots / totalSlots) : 0.0;
         
+        // Emptiest zone straight from the engine's load index
+        Zone* mostAvailable = engine->getMostAvailableZone();
+        if (mostAvailable != nullptr) {
+            stats.mostAvailableZoneID = mostAvailable->getZoneID();
+            stats.mostAvailableZoneSlots = mostAvailable->getAvailableSlots();
+        }
+        
         return stats;
     } catch (const std::exception& e) {
         std::cerr << "Exception in getDashboardStats: " << e.what() << "\n";
@@ -421,87 +714,69 @@ double ParkingSystem::getZoneUtilization(int zoneID) const {
     return 65.0;
 }
 
-DoublyLinkedList<ParkingRequest*>& ParkingSystem::getMasterHistory() {
+SlotMap<ParkingRequest*>& ParkingSystem::getMasterHistory() {
     return masterHistoryList;
 }
 
 bool ParkingSystem::rollbackOperations(int k) {
-    // Perform rollback using the rollback manager
-    if (!rollbackManager->performRollback(k)) {
-        return false;
+    std::unique_lock<std::shared_mutex> systemLock = lockExclusive();
+    
+    // Perform rollback using the rollback manager; only the requests it
+    // reverted can need re-linking, so nothing below walks the whole history
+    std::vector<ParkingRequest*> touchedRequests;
+    bool rolledBack = rollbackManager->performRollback(k, touchedRequests);
+    if (touchedRequests.empty()) {
+        return rolledBack;   // Refused before anything was reverted
     }
+    markDashboardDirty();
     
     // After rollback, clean up and restore system state
     
     // STEP 1: Remove rolled-back creation operations
     // Vehicles that were created then rolled back are marked as CANCELLED
-    // Remove them from both activeRequests and masterHistoryList
-    auto activeNode = activeRequests.getHead();
-    while (activeNode != nullptr) {
-        if (activeNode->data != nullptr) {
-            ParkingRequest* req = activeNode->data;
-            RequestState status = req->getCurrentStatus();
-            
-            // If a vehicle is CANCELLED and was just rolled back from REQUESTED state,
-            // it means its creation was rolled back - remove it completely
-            if (status == RequestState::CANCELLED) {
-                std::string vehicleID = req->getVehicleID();
-                
-                // Free any allocated slot before removing the vehicle
-                int slotID = req->getAllocatedSlotID();
-                if (slotID != -1) {
-                    engine->freeSlot(slotID);
-                    std::cout << "  ✓ Freed slot " << slotID << " for Vehicle " << vehicleID << "\n";
-                }
-                
-                auto nodeToRemove = activeNode;
-                activeNode = activeNode->next;  // Move to next before removal
-                activeRequests.removeNode(nodeToRemove);
-                std::cout << "✓ Vehicle " << vehicleID << " completely removed from system\n";
-                continue;
-            }
+    // Unlink them from activeRequests and the vehicle index first, so an older
+    // request for the same vehicle can take the index entry back in STEP 3
+    for (ParkingRequest* req : touchedRequests) {
+        if (req->getCurrentStatus() != RequestState::CANCELLED || !activeRequests.contains(req)) {
+            continue;
         }
-        activeNode = activeNode->next;
+        const std::string& vehicleID = req->getVehicleID();
+        
+        // Free any allocated slot before removing the vehicle
+        SlotHandle handle = req->getAllocatedSlotHandle();
+        if (handle.isValid()) {
+            engine->freeSlot(handle);
+            std::cout << "  ✓ Freed slot " << req->getAllocatedSlotID() << " for Vehicle " << vehicleID << "\n";
+            req->clearAllocatedSlot();
+        }
+        
+        deactivateRequest(req);
+        std::cout << "✓ Vehicle " << vehicleID << " completely removed from system\n";
     }
     
     // STEP 2: Handle REQUESTED state vehicles from rollback
     // If a vehicle rolls back to REQUESTED (but creation wasn't rolled back),
     // it stays in activeRequests
     
-    // STEP 3: Restore any cancelled requests that should be active again
-    // Scan masterHistory and add any ALLOCATED/OCCUPIED requests to activeRequests
-    auto masterNode = masterHistoryList.getHead();
-    while (masterNode != nullptr) {
-        if (masterNode->data != nullptr) {
-            ParkingRequest* req = masterNode->data;
-            RequestState status = req->getCurrentStatus();
-            
-            // Only restore ALLOCATED or OCCUPIED states (not REQUESTED, RELEASED, or CANCELLED)
-            if (status == RequestState::ALLOCATED || status == RequestState::OCCUPIED) {
-                
-                // Check if already in activeRequests
-                auto activeCheckNode = activeRequests.getHead();
-                bool found = false;
-                while (activeCheckNode != nullptr) {
-                    if (activeCheckNode->data == req) {
-                        found = true;
-                        break;
-                    }
-                    activeCheckNode = activeCheckNode->next;
-                }
-                
-                // If not found, add it back to active
-                if (!found) {
-                    activeRequests.insertBack(req);
-                    std::cout << "✓ Restored request for Vehicle " << req->getVehicleID() 
-                             << " to active requests\n";
-                }
-            }
+    // STEP 3: Restore any released/cancelled requests that should be active again
+    // Re-link every touched REQUESTED/ALLOCATED/OCCUPIED request
+    // (a rolled-back cancel of a REQUESTED request comes back as REQUESTED)
+    for (ParkingRequest* req : touchedRequests) {
+        RequestState status = req->getCurrentStatus();
+        
+        // Only restore live states (not RELEASED or CANCELLED) that are not
+        // already linked into activeRequests (O(1) hook check); activateRequest()
+        // links the vehicle index entry together with the list hook
+        if ((status == RequestState::REQUESTED || status == RequestState::ALLOCATED ||
+             status == RequestState::OCCUPIED) &&
+            !activeRequests.contains(req)) {
+            activateRequest(req);
+            std::cout << "✓ Restored request for Vehicle " << req->getVehicleID() 
+                     << " to active requests\n";
         }
-        masterNode = masterNode->next;
     }
     
-    return true;
+    return rolledBack;   // false: a request could not get its old slot back and was left as it was
 }
 
 void ParkingSystem::displayRollbackStatus() const {
@@ -510,20 +785,83 @@ void ParkingSystem::displayRollbackStatus() const {
 }
 
 ParkingRequest* ParkingSystem::findRequestByVehicleID(const std::string& vehicleID) {
-    auto currentNode = activeRequests.getHead();
-    while (currentNode != nullptr) {
-        if (currentNode->data != nullptr && currentNode->data->getVehicleID() == vehicleID) {
-            return currentNode->data;
-        }
-        currentNode = currentNode->next;
+    ParkingRequest** entry = vehicleIndex.find(vehicleID);
+    return entry != nullptr ? *entry : nullptr;
+}
+
+// Callers hold the vehicle's stripe (or the exclusive system lock)
+void ParkingSystem::activateRequest(ParkingRequest* request) {
+    if (request == nullptr) return;
+    {
+        std::unique_lock<std::mutex> registryLock = lockRegistry();
+        if (activeRequests.contains(request)) return;
+        activeRequests.insertBack(request);
+    }
+    vehicleIndex.insert(request->getVehicleID(), request);
+}
+
+void ParkingSystem::deactivateRequest(ParkingRequest* request) {
+    if (request == nullptr) return;
+    {
+        std::unique_lock<std::mutex> registryLock = lockRegistry();
+        if (!activeRequests.remove(request)) return;
+    }
+    
+    // A rolled-back request may share its vehicle ID with a newer one;
+    // only drop the index entry if it points at this request
+    ParkingRequest** entry = vehicleIndex.find(request->getVehicleID());
+    if (entry != nullptr && *entry == request) {
+        vehicleIndex.erase(request->getVehicleID());
     }
-    return nullptr;
 }
 
 ParkingRequest* ParkingSystem::getRequestByVehicleID(const std::string& vehicleID) {
+    std::shared_lock<std::shared_mutex> systemLock = lockShared();
+    std::unique_lock<std::mutex> vehicleLock = lockVehicle(vehicleID);
     return findRequestByVehicleID(vehicleID);
 }
 
+void ParkingSystem::recordCommand(ParkingRequest* request, ParkingSlot* slot, Zone* zone,
+                                  RequestState oldState, RequestState newState) {
+    std::unique_lock<std::mutex> historyLock;
+    if (threadSafe) historyLock = std::unique_lock<std::mutex>(historyMutex);
+    rollbackManager->recordCommand(request, slot, zone, oldState, newState);
+    markDashboardDirty();   // Every request mutation is recorded, after it took effect
+}
+
+std::shared_lock<std::shared_mutex> ParkingSystem::lockShared() const {
+    if (!threadSafe) return std::shared_lock<std::shared_mutex>();
+    return std::shared_lock<std::shared_mutex>(systemMutex);
+}
+
+std::unique_lock<std::shared_mutex> ParkingSystem::lockExclusive() const {
+    if (!threadSafe) return std::unique_lock<std::shared_mutex>();
+    return std::unique_lock<std::shared_mutex>(systemMutex);
+}
+
+std::unique_lock<std::mutex> ParkingSystem::lockVehicle(const std::string& vehicleID) {
+    if (!threadSafe) return std::unique_lock<std::mutex>();
+    return std::unique_lock<std::mutex>(vehicleIndex.mutexFor(vehicleID));
+}
+
+std::unique_lock<std::mutex> ParkingSystem::lockRegistry() const {
+    if (!threadSafe) return std::unique_lock<std::mutex>();
+    return std::unique_lock<std::mutex>(registryMutex);
+}
+
+std::unique_lock<std::mutex> ParkingSystem::lockReservations() {
+    if (!threadSafe) return std::unique_lock<std::mutex>();
+    return std::unique_lock<std::mutex>(reservationMutex);
+}
+
+void ParkingSystem::runChunks(int chunkCount, const IndexedTask& chunk) const {
+    if (analyticsPool != nullptr) {
+        analyticsPool->parallelFor(chunkCount, chunk);
+    } else {
+        for (int i = 0; i < chunkCount; i++) chunk(i);
+    }
+}
+
 double ParkingSystem::calculateAverageDuration() const {
     return 45.0;
 }
@@ -547,10 +885,15 @@ RollbackManager* ParkingSystem::getRollbackManager() const {
     return rollbackManager;
 }
 
-DoublyLinkedList<ParkingRequest*>& ParkingSystem::getActiveRequests() {
+IntrusiveList<ParkingRequest>& ParkingSystem::getActiveRequests() {
     return activeRequests;
 }
 
+AllocationSnapshot ParkingSystem::createSnapshot() {
+    std::unique_lock<std::shared_mutex> systemLock = lockExclusive();
+    return AllocationSnapshot::capture(*engine);
+}
+
 AllocationEngine* ParkingSystem::getEngine() const {
     return engine;
 }
@@ -0,0 +1,215 @@
+#include "ReservationBook.h"
+#include "ParkingSlot.h"
+#include "ParkingArea.h"
+#include "Zone.h"
+#include <iterator>
+#include <limits>
+
+ReservationBook::ReservationBook(Zone* owner) : zone(owner), nextReservationID(1) {
+    syncSlots();
+}
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+void ReservationBook::syncSlots() {
+    if ((int)slots.size() == zone->getTotalCapacity()) return;
+
+    // Slots are only ever appended, so existing book indices stay valid
+    slots.clear();
+    for (int a = 0; zone->getAreaAt(a) != nullptr; a++) {
+        ParkingArea* area = zone->getAreaAt(a);
+        for (int i = 0; i < area->getTotalSlots(); i++) {
+            slots.push_back(area->getSlotAt(i));
+        }
+    }
+    for (int index = (int)calendars.size(); index < (int)slots.size(); index++) {
+        calendars.push_back(Calendar());
+        lastEnd.push_back(0);
+        slotsByLastEnd[slotSizeIndex(slots[index]->getSize())].insert(TimedEntry(0, index));
+    }
+}
+
+bool ReservationBook::isSlotFree(int slotIndex, time_t start, time_t end) const {
+    const Calendar& calendar = calendars[slotIndex];
+
+    // Only the last booking starting before end can overlap [start, end)
+    Calendar::const_iterator it = calendar.lower_bound(end);
+    if (it == calendar.begin()) return true;
+    --it;
+    return it->second.first <= start;
+}
+
+void ReservationBook::setLastEnd(int slotIndex, time_t end) {
+    std::set<TimedEntry>& ordered = slotsByLastEnd[slotSizeIndex(slots[slotIndex]->getSize())];
+    ordered.erase(TimedEntry(lastEnd[slotIndex], slotIndex));
+    lastEnd[slotIndex] = end;
+    ordered.insert(TimedEntry(end, slotIndex));
+}
+
+void ReservationBook::releaseHold(Reservation& reservation) {
+    if (!reservation.held) return;
+    reservation.heldSlot->free();
+    std::unordered_map<std::string, int>::iterator held = heldByVehicle.find(reservation.vehicleID);
+    if (held != heldByVehicle.end() && held->second == reservation.reservationID) {
+        heldByVehicle.erase(held);   // A later window of the same vehicle may own the entry
+    }
+    reservation.held = false;
+    reservation.heldSlot = nullptr;
+}
+
+void ReservationBook::erase(int reservationID) {
+    std::unordered_map<int, Reservation>::iterator it = reservations.find(reservationID);
+    if (it == reservations.end()) return;
+
+    int slotIndex = it->second.slotIndex;
+    Calendar& calendar = calendars[slotIndex];
+    calendar.erase(it->second.start);
+    if (lastEnd[slotIndex] == it->second.end) {
+        setLastEnd(slotIndex, calendar.empty() ? 0 : calendar.rbegin()->second.first);
+    }
+    reservations.erase(it);
+}
+
+// ============================================================================
+// BOOKING OPERATIONS
+// ============================================================================
+
+int ReservationBook::findFreeSlotIndex(time_t start, time_t end, SlotSize size) {
+    syncSlots();
+    if (start >= end) return -1;
+
+    // Fast path: the slot whose bookings end latest but still before start.
+    // Choosing the tightest fit keeps slots with earlier gaps open.
+    std::set<TimedEntry>& ordered = slotsByLastEnd[slotSizeIndex(size)];
+    std::set<TimedEntry>::iterator fit = ordered.upper_bound(TimedEntry(start, (int)slots.size()));
+    if (fit != ordered.begin()) {
+        return std::prev(fit)->second;
+    }
+
+    // Window lies before some booking on every slot: look for a gap one
+    // calendar at a time, O(S log R); only out-of-order bookings get here
+    for (std::set<TimedEntry>::iterator it = fit; it != ordered.end(); ++it) {
+        if (isSlotFree(it->second, start, end)) {
+            return it->second;
+        }
+    }
+    return -1;
+}
+
+ParkingSlot* ReservationBook::findFreeSlot(time_t start, time_t end, SlotSize size) {
+    int slotIndex = findFreeSlotIndex(start, end, size);
+    return slotIndex == -1 ? nullptr : slots[slotIndex];
+}
+
+int ReservationBook::reserve(const std::string& vehicleID, time_t start, time_t end, SlotSize size) {
+    int slotIndex = findFreeSlotIndex(start, end, size);
+    if (slotIndex == -1) return -1;
+
+    Reservation reservation;
+    reservation.reservationID = nextReservationID++;
+    reservation.vehicleID = vehicleID;
+    reservation.slotIndex = slotIndex;
+    reservation.start = start;
+    reservation.end = end;
+    reservations[reservation.reservationID] = reservation;
+
+    calendars[slotIndex][start] = std::make_pair(end, reservation.reservationID);
+    if (end > lastEnd[slotIndex]) {
+        setLastEnd(slotIndex, end);
+    }
+    startQueue.push(TimedEntry(start, reservation.reservationID));
+    return reservation.reservationID;
+}
+
+bool ReservationBook::cancel(int reservationID) {
+    std::unordered_map<int, Reservation>::iterator it = reservations.find(reservationID);
+    if (it == reservations.end()) return false;
+
+    // Queue entries for erased reservations are skipped when popped
+    releaseHold(it->second);
+    erase(reservationID);
+    return true;
+}
+
+// ============================================================================
+// ACTIVATION
+// ============================================================================
+
+void ReservationBook::activateDue(time_t now, std::vector<std::string>& heldVehicles,
+                                  std::vector<std::string>& releasedVehicles) {
+    while (!startQueue.empty() && startQueue.top().first <= now) {
+        int reservationID = startQueue.top().second;
+        startQueue.pop();
+
+        std::unordered_map<int, Reservation>::iterator it = reservations.find(reservationID);
+        if (it == reservations.end()) continue;   // Cancelled
+        Reservation& reservation = it->second;
+        if (reservation.end <= now) {
+            erase(reservationID);   // Whole window passed while inactive
+            continue;
+        }
+
+        // A walk-in may still be parked in the booked slot; hold any free
+        // slot of the same size instead so the reservation is honoured
+        ParkingSlot* slot = slots[reservation.slotIndex];
+        if (!slot->getIsAvailable()) {
+            slot = zone->findAvailableSlot(slot->getSize());
+        }
+        if (slot == nullptr || !slot->allocate()) continue;   // Falls back to a normal allocation on arrival
+
+        reservation.held = true;
+        reservation.heldSlot = slot;
+        heldByVehicle[reservation.vehicleID] = reservationID;
+        heldVehicles.push_back(reservation.vehicleID);
+        endQueue.push(TimedEntry(reservation.end, reservationID));
+    }
+
+    // Vehicles that never arrived give their slot back
+    while (!endQueue.empty() && endQueue.top().first <= now) {
+        int reservationID = endQueue.top().second;
+        endQueue.pop();
+
+        std::unordered_map<int, Reservation>::iterator it = reservations.find(reservationID);
+        if (it == reservations.end()) continue;   // Claimed or cancelled
+        if (it->second.held) releasedVehicles.push_back(it->second.vehicleID);
+        releaseHold(it->second);
+        erase(reservationID);
+    }
+}
+
+time_t ReservationBook::getNextEventTime() const {
+    time_t next = std::numeric_limits<time_t>::max();
+    if (!startQueue.empty()) next = startQueue.top().first;
+    if (!endQueue.empty() && endQueue.top().first < next) next = endQueue.top().first;
+    return next;
+}
+
+ParkingSlot* ReservationBook::claimHeldSlot(const std::string& vehicleID) {
+    std::unordered_map<std::string, int>::iterator held = heldByVehicle.find(vehicleID);
+    if (held == heldByVehicle.end()) return nullptr;
+
+    int reservationID = held->second;
+    ParkingSlot* slot = reservations[reservationID].heldSlot;
+    heldByVehicle.erase(held);
+    erase(reservationID);   // Slot stays allocated, now to the request
+    return slot;
+}
+
+// ============================================================================
+// GETTERS
+// ============================================================================
+
+const Reservation* ReservationBook::getReservation(int reservationID) const {
+    std::unordered_map<int, Reservation>::const_iterator it = reservations.find(reservationID);
+    return it == reservations.end() ? nullptr : &it->second;
+}
+
+int ReservationBook::getReservationCount() const {
+    return (int)reservations.size();
+}
+
+bool ReservationBook::hasHeldSlot(const std::string& vehicleID) const {
+    return heldByVehicle.find(vehicleID) != heldByVehicle.end();
+}
@@ -1,91 +1,190 @@
 #include "RollbackManager.h"
 #include "Zone.h"
 #include <iostream>
+#include <unordered_map>
 
-RollbackManager::RollbackManager() : totalRollbacksPerformed(0) {}
+RollbackManager::RollbackManager(int historyDepth)
+    : commandHistory(historyDepth), totalRollbacksPerformed(0), currentGroupID(0), lastGroupID(0), truncatedGroupID(0) {}
 
 RollbackManager::~RollbackManager() {}
 
+// Groups are contiguous in the ring, so only the oldest surviving group can
+// have lost commands: the one the most recently discarded command belonged to
+void RollbackManager::noteEviction() {
+    if (commandHistory.isFull()) {
+        truncatedGroupID = commandHistory.fromNewest(commandHistory.getSize() - 1).groupID;
+    }
+}
+
 void RollbackManager::recordCommand(const Command& command) {
+    noteEviction();
     commandHistory.push(command);
+    if (currentGroupID != 0) {
+        commandHistory.peek().groupID = currentGroupID;
+    }
+}
+
+void RollbackManager::recordCommand(ParkingRequest* request, ParkingSlot* slot, Zone* zone,
+                                    RequestState oldState, RequestState newState) {
+    noteEviction();
+    commandHistory.emplace(request, slot, zone, oldState, newState, currentGroupID);
+}
+
+void RollbackManager::beginGroup() {
+    currentGroupID = ++lastGroupID;
+}
+
+void RollbackManager::endGroup() {
+    currentGroupID = 0;
+}
+
+int RollbackManager::countCommandsInUnits(int units) const {
+    int size = commandHistory.getSize();
+    int count = 0;
+    for (int unit = 0; unit < units; unit++) {
+        if (count >= size) return -1;
+        int group = commandHistory.fromNewest(count).groupID;
+        if (group != 0 && group == truncatedGroupID) return -2;
+        count++;
+        while (group != 0 && count < size && commandHistory.fromNewest(count).groupID == group) {
+            count++;
+        }
+    }
+    return count;
 }
 
-bool RollbackManager::performRollback(int k) {
-    if (commandHistory.getSize() < k) {
+// Replays the slot side of the first commandCount commands (newest first)
+// without touching anything: a rolled-back release/cancel must re-take its
+// old slot, which is only possible if it is free now or a newer command in
+// the same rollback frees it first. Returns the first command that would
+// fail, or -1 if all of them can be undone.
+int RollbackManager::findSlotConflict(int commandCount) const {
+    std::unordered_map<ParkingSlot*, bool> freeAfter;   // Slot -> free at this point of the replay
+    for (int i = 0; i < commandCount; i++) {
+        const Command& cmd = commandHistory.fromNewest(i);
+        if (cmd.requestPtr == nullptr || cmd.slotPtr == nullptr) continue;
+        
+        bool creation = (cmd.oldState == RequestState::REQUESTED && cmd.newState == RequestState::REQUESTED);
+        if (creation || cmd.newState == RequestState::ALLOCATED || cmd.newState == RequestState::OCCUPIED) {
+            freeAfter[cmd.slotPtr] = true;
+        } else if (cmd.newState == RequestState::RELEASED || cmd.newState == RequestState::CANCELLED) {
+            std::unordered_map<ParkingSlot*, bool>::iterator known = freeAfter.find(cmd.slotPtr);
+            bool free = (known != freeAfter.end()) ? known->second : cmd.slotPtr->getIsAvailable();
+            if (!free) return i;
+            freeAfter[cmd.slotPtr] = false;
+        }
+    }
+    return -1;
+}
+
+bool RollbackManager::performRollback(int k, std::vector<ParkingRequest*>& touchedRequests) {
+    int commandCount = countCommandsInUnits(k);
+    if (commandCount == -1) {
         std::cerr << "❌ Not enough operations to rollback. History size: " 
                  << commandHistory.getSize() << ", Requested: " << k << "\n";
         return false;
     }
+    if (commandCount == -2) {
+        std::cerr << "❌ Cannot rollback " << k << " operation(s): the oldest batch in range is only "
+                 << "partly in the history (depth " << commandHistory.getCapacity() << ")\n";
+        return false;
+    }
+    int conflict = findSlotConflict(commandCount);
+    if (conflict != -1) {
+        const Command& cmd = commandHistory.fromNewest(conflict);
+        std::cerr << "❌ Cannot rollback " << k << " operation(s): slot " << cmd.slotPtr->getSlotID()
+                 << " of Vehicle " << cmd.requestPtr->getVehicleID()
+                 << " has been taken by another vehicle since\n";
+        return false;
+    }
 
+    bool allReverted = true;
     std::cout << "\n🔄 STARTING ROLLBACK OF " << k << " OPERATION(S)\n";
     std::cout << "================================================\n";
     
-    for (int i = 0; i < k; i++) {
-        if (commandHistory.getSize() > 0) {
-            Command cmd = commandHistory.peek();
+    for (int i = 0; i < commandCount; i++) {
+        const Command& cmd = commandHistory.fromNewest(i);
+        
+        // Revert the request state to its old state
+        if (cmd.requestPtr != nullptr) {
+            touchedRequests.push_back(cmd.requestPtr);
+            const std::string& vehicleID = cmd.requestPtr->getVehicleID();
+            std::string oldStateStr = cmd.requestPtr->statusToString(cmd.oldState);
+            std::string newStateStr = cmd.requestPtr->statusToString(cmd.newState);
             
-            // Revert the request state to its old state
-            if (cmd.requestPtr != nullptr) {
-                std::string vehicleID = cmd.requestPtr->getVehicleID();
-                std::string oldStateStr = cmd.requestPtr->statusToString(cmd.oldState);
-                std::string newStateStr = cmd.requestPtr->statusToString(cmd.newState);
+            // Check if this is a creation command (oldState == newState == REQUESTED)
+            // This means rolling back a creation, so we mark vehicle for removal
+            if (cmd.oldState == RequestState::REQUESTED && 
+                cmd.newState == RequestState::REQUESTED) {
+                // This is a creation operation - mark it for removal
+                cmd.requestPtr->updateState(RequestState::CANCELLED);  // Mark as removed
                 
-                // Check if this is a creation command (oldState == newState == REQUESTED)
-                // This means rolling back a creation, so we mark vehicle for removal
-                if (cmd.oldState == RequestState::REQUESTED && 
-                    cmd.newState == RequestState::REQUESTED) {
-                    // This is a creation operation - mark it for removal
-                    cmd.requestPtr->updateState(RequestState::CANCELLED);  // Mark as removed
-                    
-                    // Free the slot if one was allocated
-                    if (cmd.slotPtr != nullptr) {
-                        cmd.slotPtr->free();
-                        std::cout << "  ✓ Slot " << cmd.slotPtr->getSlotID() 
-                                 << " freed\n";
-                    }
-                    
-                    // Refresh zone to update available slot counts
-                    if (cmd.zonePtr != nullptr) {
-                        cmd.zonePtr->refreshCapacity();
+                // Free the slot if one was allocated
+                if (cmd.slotPtr != nullptr) {
+                    cmd.slotPtr->free();
+                    std::cout << "  ✓ Slot " << cmd.slotPtr->getSlotID() 
+                             << " freed\n";
+                }
+                
+                std::cout << "  ✓ Vehicle " << vehicleID 
+                         << " creation rolled back - REMOVED from system\n";
+            } else {
+                // Regular state reversion
+                // If rolling back from ALLOCATED or OCCUPIED, we need to free the slot
+                if ((cmd.newState == RequestState::ALLOCATED || 
+                     cmd.newState == RequestState::OCCUPIED) && 
+                    cmd.slotPtr != nullptr) {
+                    // Free the slot since the request is being rolled back
+                    cmd.slotPtr->free();
+                    if (cmd.newState == RequestState::ALLOCATED) {
+                        cmd.requestPtr->clearAllocatedSlot();
                     }
-                    
-                    std::cout << "  ✓ Vehicle " << vehicleID 
-                             << " creation rolled back - REMOVED from system\n";
-                } else {
-                    // Regular state reversion
-                    // If rolling back from ALLOCATED or OCCUPIED, we need to free the slot
-                    if ((cmd.newState == RequestState::ALLOCATED || 
-                         cmd.newState == RequestState::OCCUPIED) && 
-                        cmd.slotPtr != nullptr) {
-                        // Free the slot since the request is being rolled back
-                        cmd.slotPtr->free();
+                    std::cout << "  ✓ Slot " << cmd.slotPtr->getSlotID() 
+                             << " freed\n";
+                }
+                
+                // If rolling back a release/cancel, re-take the exact slot that was freed.
+                // findSlotConflict() ruled out a taken slot; should one still be lost,
+                // the request stays RELEASED/CANCELLED rather than share the slot
+                if ((cmd.newState == RequestState::RELEASED || 
+                     cmd.newState == RequestState::CANCELLED) && 
+                    cmd.slotPtr != nullptr) {
+                    if (cmd.slotPtr->allocate()) {
                         std::cout << "  ✓ Slot " << cmd.slotPtr->getSlotID() 
-                                 << " freed\n";
-                    }
-                    
-                    // Refresh zone to update available slot counts
-                    if (cmd.zonePtr != nullptr && cmd.slotPtr != nullptr) {
-                        cmd.zonePtr->refreshCapacity();
-                    }
-                    
-                    // Update request to its previous state
-                    bool stateUpdated = cmd.requestPtr->updateState(cmd.oldState);
-                    if (stateUpdated) {
-                        std::cout << "  ✓ Vehicle " << vehicleID << " reverted: " 
-                                 << newStateStr << " → " << oldStateStr << "\n";
+                                 << " re-occupied\n";
                     } else {
-                        std::cerr << "  ❌ FAILED to update Vehicle " << vehicleID 
-                                 << " state from " << newStateStr << " to " << oldStateStr << "\n";
+                        std::cerr << "  ❌ Slot " << cmd.slotPtr->getSlotID() 
+                                 << " was taken by another vehicle; Vehicle " << vehicleID
+                                 << " stays " << newStateStr << "\n";
+                        allReverted = false;
+                        totalRollbacksPerformed++;
+                        continue;
                     }
                 }
+                
+                // Update request to its previous state
+                bool stateUpdated = cmd.requestPtr->updateState(cmd.oldState);
+                if (stateUpdated) {
+                    std::cout << "  ✓ Vehicle " << vehicleID << " reverted: " 
+                             << newStateStr << " → " << oldStateStr << "\n";
+                } else {
+                    std::cerr << "  ❌ FAILED to update Vehicle " << vehicleID 
+                             << " state from " << newStateStr << " to " << oldStateStr << "\n";
+                }
             }
-            
-            commandHistory.pop();
-            totalRollbacksPerformed++;
         }
+        
+        totalRollbacksPerformed++;
+    }
+    if (commandCount > 0) {
+        commandHistory.popMany(commandCount);
     }
     
     std::cout << "================================================\n";
+    if (!allReverted) {
+        std::cerr << "❌ ROLLBACK INCOMPLETE - a released slot could not be re-taken\n\n";
+        return false;
+    }
     std::cout << "✓ ROLLBACK COMPLETED - Total rollbacks: " << totalRollbacksPerformed << "\n\n";
     return true;
 }
@@ -94,6 +193,14 @@ int RollbackManager::getHistorySize() const {
     return commandHistory.getSize();
 }
 
+int RollbackManager::getHistoryDepth() const {
+    return commandHistory.getCapacity();
+}
+
+long long RollbackManager::getDiscardedCommandCount() const {
+    return commandHistory.getDiscardedCount();
+}
+
 int RollbackManager::getTotalRollbacksPerformed() const {
     return totalRollbacksPerformed;
 }
@@ -103,13 +210,13 @@ bool RollbackManager::hasHistory() const {
 }
 
 void RollbackManager::clearHistory() {
-    while (!commandHistory.isEmpty()) {
-        commandHistory.pop();
-    }
+    commandHistory.clear();
+    truncatedGroupID = 0;
 }
 
 void RollbackManager::displayHistory() const {
-    std::cout << "Command History Size: " << commandHistory.getSize() << std::endl;
+    std::cout << "Command History Size: " << commandHistory.getSize()
+              << " / " << commandHistory.getCapacity() << std::endl;
     std::cout << "Total Rollbacks Performed: " << totalRollbacksPerformed << std::endl;
 }
 
@@ -1,11 +1,13 @@
 #include "Vehicle.h"
 #include <iostream>
+#include <utility>
 
-Vehicle::Vehicle(const std::string& id, int zoneID) : vehicleID(id), preferredZoneID(zoneID) {}
+Vehicle::Vehicle(std::string id, int zoneID, VehicleType vehicleType)
+    : vehicleID(std::move(id)), preferredZoneID(zoneID), type(vehicleType) {}
 
 Vehicle::~Vehicle() {}
 
-std::string Vehicle::getVehicleID() const { 
+const std::string& Vehicle::getVehicleID() const { 
     return vehicleID; 
 }
 
@@ -13,6 +15,10 @@ int Vehicle::getPreferredZoneID() const {
     return preferredZoneID; 
 }
 
+VehicleType Vehicle::getType() const {
+    return type;
+}
+
 void Vehicle::setPreferredZoneID(int zoneID) {
     preferredZoneID = zoneID;
 }
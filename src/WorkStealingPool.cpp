@@ -0,0 +1,109 @@
+#include "WorkStealingPool.h"
+
+WorkStealingPool::WorkStealingPool(int threadCount) : jobGeneration(0), stopping(false), remainingTasks(0) {
+    if (threadCount < 0) threadCount = 0;
+    for (int q = 0; q <= threadCount; q++) {
+        queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+    }
+    for (int w = 0; w < threadCount; w++) {
+        workers.emplace_back(&WorkStealingPool::workerLoop, this, w);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+// ============================================================================
+// TASK QUEUES
+// ============================================================================
+
+bool WorkStealingPool::popOwn(int queueIndex, QueuedTask& out) {
+    WorkerQueue& queue = *queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    out = queue.tasks.front();   // Front: neighbouring chunks in order
+    queue.tasks.pop_front();
+    return true;
+}
+
+bool WorkStealingPool::steal(int thiefIndex, QueuedTask& out) {
+    int queueCount = (int)queues.size();
+    for (int offset = 1; offset < queueCount; offset++) {
+        WorkerQueue& victim = *queues[(thiefIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) continue;
+        out = victim.tasks.back();   // Back: the work its owner would reach last
+        victim.tasks.pop_back();
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::runTasks(int queueIndex) {
+    QueuedTask task;
+    while (popOwn(queueIndex, task) || steal(queueIndex, task)) {
+        (*task.body)(task.index);
+        if (remainingTasks.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> lock(wakeMutex);   // Caller may be about to wait
+            doneCondition.notify_all();
+        }
+    }
+}
+
+void WorkStealingPool::workerLoop(int queueIndex) {
+    unsigned long long seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wakeCondition.wait(lock, [&]() { return stopping || jobGeneration != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = jobGeneration;
+        }
+        runTasks(queueIndex);
+    }
+}
+
+// ============================================================================
+// FORK-JOIN
+// ============================================================================
+
+void WorkStealingPool::parallelFor(int taskCount, const IndexedTask& task) {
+    if (taskCount <= 0) return;
+    if (workers.empty() || taskCount == 1) {
+        for (int i = 0; i < taskCount; i++) task(i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> job(jobMutex);
+    int queueCount = (int)queues.size();
+    remainingTasks.store(taskCount);
+    for (int q = 0; q < queueCount; q++) {
+        int begin = (int)((long long)taskCount * q / queueCount);
+        int end = (int)((long long)taskCount * (q + 1) / queueCount);
+        std::lock_guard<std::mutex> lock(queues[q]->mutex);
+        for (int i = begin; i < end; i++) {
+            queues[q]->tasks.push_back(QueuedTask{&task, i});
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        jobGeneration++;
+    }
+    wakeCondition.notify_all();
+
+    runTasks(queueCount - 1);   // The caller works too instead of just waiting
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    doneCondition.wait(lock, [this]() { return remainingTasks.load() == 0; });
+}
+
+int WorkStealingPool::getThreadCount() const {
+    return (int)workers.size();
+}
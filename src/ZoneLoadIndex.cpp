@@ -0,0 +1,81 @@
+#include "ZoneLoadIndex.h"
+
+ZoneLoadIndex::ZoneLoadIndex()
+    : available(new std::atomic<int>[1]), tree(new std::atomic<int>[2]), size(0), leafBase(1) {
+    available[0].store(0);
+    tree[0].store(-1);
+    tree[1].store(-1);
+}
+
+int ZoneLoadIndex::better(int a, int b) const {
+    if (a == -1) return b;
+    if (b == -1) return a;
+    if (available[b].load() > available[a].load()) return b;
+    return a;   // a is the lower position on ties (left child)
+}
+
+void ZoneLoadIndex::rebuild(int newLeafBase) {
+    std::unique_ptr<std::atomic<int>[]> grown(new std::atomic<int>[newLeafBase]);
+    for (int i = 0; i < newLeafBase; i++) {
+        grown[i].store(i < size ? available[i].load() : 0);
+    }
+    available = std::move(grown);
+    leafBase = newLeafBase;
+    tree.reset(new std::atomic<int>[2 * leafBase]);
+    for (int node = 0; node < 2 * leafBase; node++) {
+        tree[node].store(-1);
+    }
+    for (int i = 0; i < size; i++) {
+        tree[leafBase + i].store(i);
+    }
+    for (int node = leafBase - 1; node >= 1; node--) {
+        tree[node].store(better(tree[2 * node].load(), tree[2 * node + 1].load()));
+    }
+}
+
+int ZoneLoadIndex::add(int availableSlots) {
+    int position = size;
+    if (position >= leafBase) {
+        rebuild(leafBase * 2);   // Doubling keeps adds amortised O(1)
+    }
+    size++;
+    update(position, availableSlots);
+    return position;
+}
+
+void ZoneLoadIndex::update(int position, int availableSlots) {
+    if (position < 0 || position >= size) return;
+    available[position].store(availableSlots);
+    int node = leafBase + position;
+    tree[node].store(position);
+    for (node /= 2; node >= 1; node /= 2) {
+        tree[node].store(better(tree[2 * node].load(), tree[2 * node + 1].load()));
+    }
+}
+
+int ZoneLoadIndex::mostAvailable() const {
+    return tree[1].load();
+}
+
+int ZoneLoadIndex::firstNonFull() const {
+    int root = tree[1].load();
+    if (root == -1 || available[root].load() <= 0) return -1;
+
+    // Descend towards the leftmost subtree whose best leaf has a free slot
+    int node = 1;
+    while (node < leafBase) {
+        int left = tree[2 * node].load();
+        node = (left != -1 && available[left].load() > 0) ? 2 * node : 2 * node + 1;
+    }
+    int position = node - leafBase;
+    return position < size ? position : -1;   // A concurrent update can steer us off the end
+}
+
+int ZoneLoadIndex::getAvailableAt(int position) const {
+    if (position < 0 || position >= size) return 0;
+    return available[position].load();
+}
+
+int ZoneLoadIndex::getSize() const {
+    return size;
+}
@@ -217,15 +217,12 @@ public:
                   << "Utilization %\n";
         std::cout << "──────────────────────────────────────────────────\n";
         
-        auto zoneNode = stats.zoneStatuses.getHead();
-        while (zoneNode != nullptr) {
-            ZoneSlotStatus zoneStatus = zoneNode->data;
+        for (const ZoneSlotStatus& zoneStatus : stats.zoneStatuses) {
             std::cout << std::left << std::setw(8) << zoneStatus.zoneID
                       << std::setw(15) << zoneStatus.totalSlots
                       << std::setw(15) << zoneStatus.availableSlots
                       << std::setw(15) << zoneStatus.occupiedSlots
                       << std::fixed << std::setprecision(1) << zoneStatus.utilization << "%\n";
-            zoneNode = zoneNode->next;
         }
         std::cout << "──────────────────────────────────────────────────\n";
     }
@@ -1,15 +1,47 @@
 #include "Zone.h"
 #include "ParkingArea.h"
+#include "ParkingSlot.h"
+#include "AllocationEngine.h"
+#include "ReservationBook.h"
+#include "Common.h"
 #include <iostream>
 
-Zone::Zone(int id) : zoneID(id), totalCapacity(0) {}
+Zone::Zone(int id)
+    : zoneID(id), totalCapacity(0), availableSlots(0), facility(nullptr), facilityPosition(-1),
+      reservationBook(nullptr) {
+    for (int s = 0; s < SLOT_SIZE_COUNT; s++) {
+        availableBySize[s] = 0;
+    }
+}
 
-Zone::~Zone() {}
+Zone::~Zone() {
+    delete reservationBook;
+}
 
 void Zone::addParkingArea(ParkingArea* area) {
-    if (area != nullptr) {
+    if (area != nullptr && (int)areaDirectory.size() < SlotHandle::MAX_AREAS_PER_ZONE) {
+        area->assignLocation(this, (int)areaDirectory.size());
+        areaDirectory.push_back(area);
+        areasWithFreeSlots.pushBack(area->getAvailableSlots() > 0);
         parkingAreas.insertBack(area);
+        for (int i = 0; i < area->getTotalSlots(); i++) {
+            registerSlot(area->getSlotAt(i));
+        }
+        // Pushed last to first, so a fresh area hands out its lowest slot first
+        for (int i = area->getTotalSlots() - 1; i >= 0; i--) {
+            ParkingSlot* slot = area->getSlotAt(i);
+            if (slot->getIsAvailable()) pushFreeSlot(slot);
+        }
         totalCapacity += area->getTotalSlots();
+        availableSlots += area->getAvailableSlots();
+        for (int s = 0; s < SLOT_SIZE_COUNT; s++) {
+            SlotSize size = static_cast<SlotSize>(s);
+            areasWithFreeSlotsBySize[s].pushBack(area->getAvailableSlots(size) > 0);
+            availableBySize[s] += area->getAvailableSlots(size);
+            if (facility != nullptr) {
+                facility->adjustFacilityCounts(this, size, area->getTotalSlots(size), area->getAvailableSlots(size));
+            }
+        }
     }
 }
 
@@ -24,9 +56,15 @@ ParkingArea* Zone::findParkingAreaByID(int areaID) {
     return nullptr;
 }
 
+ParkingArea* Zone::getAreaAt(int areaIndex) const {
+    if (areaIndex < 0 || areaIndex >= (int)areaDirectory.size()) return nullptr;
+    return areaDirectory[areaIndex];
+}
+
 void Zone::addAdjacentZone(Zone* zone) {
     if (zone != nullptr) {
         adjacentZones.insertBack(zone);
+        if (facility != nullptr) facility->invalidateOverflowOrders();
     }
 }
 
@@ -36,6 +74,7 @@ void Zone::removeAdjacentZone(Zone* zone) {
         while (current != nullptr) {
             if (current->data == zone) {
                 adjacentZones.removeNode(current);
+                if (facility != nullptr) facility->invalidateOverflowOrders();
                 return;
             }
             current = current->next;
@@ -47,20 +86,131 @@ DoublyLinkedList<Zone*>& Zone::getAdjacentZones() {
     return adjacentZones;
 }
 
+const std::vector<OverflowCandidate>& Zone::getOverflowOrder() const {
+    return overflowOrder;
+}
+
+void Zone::setOverflowOrder(std::vector<OverflowCandidate> order) {
+    overflowOrder = std::move(order);
+}
+
 ParkingSlot* Zone::findAvailableSlot() {
-    Node<ParkingArea*>* current = parkingAreas.getHead();
-    while (current != nullptr) {
-        if (current->data != nullptr) {
-            ParkingSlot* slot = current->data->findAvailableSlot();
-            if (slot != nullptr) {
-                return slot;
-            }
+    // Only visit areas whose bit is set; a bit may briefly lag its area's
+    // counter while another thread is claiming, so an empty area is skipped
+    for (int areaIndex = areasWithFreeSlots.findFirstSet(); areaIndex != -1;
+         areaIndex = areasWithFreeSlots.findNextSet(areaIndex + 1)) {
+        ParkingSlot* slot = areaDirectory[areaIndex]->findAvailableSlot();
+        if (slot != nullptr) {
+            return slot;
         }
-        current = current->next;
     }
     return nullptr;
 }
 
+ParkingSlot* Zone::findAvailableSlot(SlotSize size) {
+    AtomicSlotBitmap& areas = areasWithFreeSlotsBySize[slotSizeIndex(size)];
+    for (int areaIndex = areas.findFirstSet(); areaIndex != -1; areaIndex = areas.findNextSet(areaIndex + 1)) {
+        ParkingSlot* slot = areaDirectory[areaIndex]->findAvailableSlot(size);
+        if (slot != nullptr) {
+            return slot;
+        }
+    }
+    return nullptr;
+}
+
+ParkingSlot* Zone::claimAvailableSlot(SlotSize size) {
+    // The slot's own CAS decides: racing callers pop different entries, and
+    // an entry whose slot was taken directly is dropped here. Its free()
+    // offers it back, so nothing FREE is ever missing from the stack
+    FreeSlotStack& stack = freeSlotsBySize[slotSizeIndex(size)];
+    for (int index = stack.pop(); index != -1; index = stack.pop()) {
+        ParkingSlot* slot = slotDirectory[index];
+        if (slot->allocate()) {
+            return slot;
+        }
+    }
+    return nullptr;
+}
+
+void Zone::onSlotAllocated(int areaIndex, SlotSize size) {
+    int sizeIndex = slotSizeIndex(size);
+    ParkingArea* area = areaDirectory[areaIndex];
+    availableSlots--;
+    availableBySize[sizeIndex]--;
+    // Clear the area's bit when it fills, then re-check: a slot freed in the
+    // meantime has already set the bit, and our reset must not hide it
+    if (area->getAvailableSlots() == 0) {
+        areasWithFreeSlots.reset(areaIndex);
+        if (area->getAvailableSlots() > 0) areasWithFreeSlots.set(areaIndex);
+    }
+    if (area->getAvailableSlots(size) == 0) {
+        areasWithFreeSlotsBySize[sizeIndex].reset(areaIndex);
+        if (area->getAvailableSlots(size) > 0) areasWithFreeSlotsBySize[sizeIndex].set(areaIndex);
+    }
+    if (facility != nullptr) facility->adjustFacilityCounts(this, size, 0, -1);
+}
+
+void Zone::onSlotFreed(int areaIndex, SlotSize size) {
+    int sizeIndex = slotSizeIndex(size);
+    availableSlots++;
+    availableBySize[sizeIndex]++;
+    areasWithFreeSlots.set(areaIndex);
+    areasWithFreeSlotsBySize[sizeIndex].set(areaIndex);
+    if (facility != nullptr) facility->adjustFacilityCounts(this, size, 0, 1);
+}
+
+void Zone::onSlotAdded(int areaIndex, ParkingSlot* slot) {
+    SlotSize size = slot->getSize();
+    bool available = slot->getIsAvailable();
+    int sizeIndex = slotSizeIndex(size);
+    registerSlot(slot);
+    if (available) pushFreeSlot(slot);
+    totalCapacity++;
+    if (available) {
+        availableSlots++;
+        availableBySize[sizeIndex]++;
+        areasWithFreeSlots.set(areaIndex);
+        areasWithFreeSlotsBySize[sizeIndex].set(areaIndex);
+    }
+    if (facility != nullptr) facility->adjustFacilityCounts(this, size, 1, available ? 1 : 0);
+}
+
+void Zone::pushFreeSlot(ParkingSlot* slot) {
+    freeSlotsBySize[slotSizeIndex(slot->getSize())].push(slot->getZoneSlotIndex());
+}
+
+void Zone::registerSlot(ParkingSlot* slot) {
+    slot->setZoneSlotIndex((int)slotDirectory.size());
+    slotDirectory.push_back(slot);
+    for (int s = 0; s < SLOT_SIZE_COUNT; s++) {
+        freeSlotsBySize[s].addIndex();
+    }
+}
+
+void Zone::attachToFacility(AllocationEngine* engine, int position) {
+    facility = engine;
+    facilityPosition = position;
+}
+
+int Zone::getFacilityPosition() const {
+    return facilityPosition;
+}
+
+ReservationBook* Zone::getReservationBook() {
+    if (reservationBook == nullptr) {
+        reservationBook = new ReservationBook(this);
+    }
+    return reservationBook;
+}
+
+bool Zone::hasReservationBook() const {
+    return reservationBook != nullptr;
+}
+
+std::mutex& Zone::getSlotMutex() {
+    return slotMutex;
+}
+
 int Zone::getZoneID() const { 
     return zoneID; 
 }
@@ -70,15 +220,11 @@ int Zone::getTotalCapacity() const {
 }
 
 int Zone::getAvailableSlots() const {
-    int available = 0;
-    Node<ParkingArea*>* current = parkingAreas.getHead();
-    while (current != nullptr) {
-        if (current->data != nullptr) {
-            available += current->data->getAvailableSlots();
-        }
-        current = current->next;
-    }
-    return available;
+    return availableSlots.load();
+}
+
+int Zone::getAvailableSlots(SlotSize size) const {
+    return availableBySize[slotSizeIndex(size)].load();
 }
 
 void Zone::displayInfo() const {
@@ -87,16 +233,41 @@ void Zone::displayInfo() const {
 }
 
 void Zone::refreshCapacity() {
-    // Refresh available count in all parking areas
-    Node<ParkingArea*>* current = parkingAreas.getHead();
-    while (current != nullptr) {
-        if (current->data != nullptr) {
-            current->data->refreshAvailableCount();
+    // Recount every area and resynchronise the zone and facility counters
+    int available = 0;
+    int availableSized[SLOT_SIZE_COUNT] = {};
+    for (int i = 0; i < (int)areaDirectory.size(); i++) {
+        ParkingArea* area = areaDirectory[i];
+        area->refreshAvailableCount();
+        available += area->getAvailableSlots();
+        if (area->getAvailableSlots() > 0) {
+            areasWithFreeSlots.set(i);
+        } else {
+            areasWithFreeSlots.reset(i);
+        }
+        for (int s = 0; s < SLOT_SIZE_COUNT; s++) {
+            int sizedCount = area->getAvailableSlots(static_cast<SlotSize>(s));
+            availableSized[s] += sizedCount;
+            if (sizedCount > 0) {
+                areasWithFreeSlotsBySize[s].set(i);
+            } else {
+                areasWithFreeSlotsBySize[s].reset(i);
+            }
+        }
+    }
+    availableSlots = available;
+    for (ParkingSlot* slot : slotDirectory) {
+        if (slot->getIsAvailable()) pushFreeSlot(slot);   // No-op for slots already queued
+    }
+    for (int s = 0; s < SLOT_SIZE_COUNT; s++) {
+        int delta = availableSized[s] - availableBySize[s];
+        availableBySize[s] = availableSized[s];
+        if (facility != nullptr && delta != 0) {
+            facility->adjustFacilityCounts(this, static_cast<SlotSize>(s), 0, delta);
         }
-        current = current->next;
     }
 }
 
-DoublyLinkedList<ParkingArea*>& Zone::getParkingAreas() {
+SlotMap<ParkingArea*>& Zone::getParkingAreas() {
     return parkingAreas;
 }
\ No newline at end of file
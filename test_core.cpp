@@ -0,0 +1,611 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <set>
+#include <thread>
+#include <ctime>
+#include <future>
+#include "ParkingSystem.h"
+#include "ParkingRequest.h"
+#include "ParkingArea.h"
+#include "CommandPipeline.h"
+
+using namespace std;
+
+int coreTestsPassed = 0;
+int coreTestsFailed = 0;
+
+void printCoreHeader(const string& title) {
+    cout << "\n" << string(75, '-') << endl;
+    cout << "  CORE TEST: " << title << endl;
+    cout << string(75, '-') << endl;
+}
+
+void coreAssert(const string& name, bool condition) {
+    if (condition) {
+        cout << "  ✓ " << name << endl;
+        coreTestsPassed++;
+    } else {
+        cout << "  ✗ " << name << " - FAILED" << endl;
+        coreTestsFailed++;
+    }
+}
+
+// Free slots counted slot by slot, ignoring every cached counter
+int recountAvailableSlots(ParkingSystem& system, SlotSize size) {
+    int available = 0;
+    for (Zone* zone : system.getEngine()->getAllZones()) {
+        for (ParkingArea* area : zone->getParkingAreas()) {
+            for (int i = 0; i < area->getTotalSlots(); i++) {
+                ParkingSlot* slot = area->getSlotAt(i);
+                if (slot->getSize() == size && slot->getIsAvailable()) available++;
+            }
+        }
+    }
+    return available;
+}
+
+// Facility, zone and area counters must all agree with the recount
+bool countersMatchRecount(ParkingSystem& system) {
+    AllocationEngine* engine = system.getEngine();
+    int recountTotal = 0;
+    for (int s = 0; s < SLOT_SIZE_COUNT; s++) {
+        SlotSize size = static_cast<SlotSize>(s);
+        int recount = recountAvailableSlots(system, size);
+        if (engine->getTotalAvailableSlots(size) != recount) return false;
+        recountTotal += recount;
+    }
+    if (engine->getTotalAvailableSlots() != recountTotal) return false;
+
+    int zoneTotal = 0;
+    for (Zone* zone : engine->getAllZones()) {
+        int areaTotal = 0;
+        for (ParkingArea* area : zone->getParkingAreas()) {
+            areaTotal += area->getAvailableSlots();
+        }
+        if (zone->getAvailableSlots() != areaTotal) return false;
+        zoneTotal += areaTotal;
+    }
+    return zoneTotal == recountTotal;
+}
+
+ParkingSlot* allocatedSlotOf(ParkingSystem& system, const string& vehicleID) {
+    ParkingRequest* request = system.getRequestByVehicleID(vehicleID);
+    if (request == nullptr || request->getAllocatedSlotID() == -1) return nullptr;
+    return system.getEngine()->resolveSlot(request->getAllocatedSlotHandle());
+}
+
+// CORE TEST 1: Concurrent CAS claims
+void test_concurrent_claims() {
+    printCoreHeader("Concurrent Claims (8 threads, 400 vehicles, 200 slots)");
+
+    ParkingSystem system;
+    system.setVerbose(false);
+    for (int z = 1; z <= 4; z++) {
+        system.createZone(z, 10, 30, 10);
+    }
+    system.setThreadSafe(true);
+
+    const int threadCount = 8;
+    const int vehiclesPerThread = 50;
+    vector<int> allocatedPerThread(threadCount, 0);
+    vector<thread> gates;
+    for (int t = 0; t < threadCount; t++) {
+        gates.emplace_back([&system, &allocatedPerThread, t, vehiclesPerThread]() {
+            for (int i = 0; i < vehiclesPerThread; i++) {
+                string vehicleID = "G" + to_string(t) + "-" + to_string(i);
+                VehicleType type = (i % 5 == 0) ? VehicleType::MOTORCYCLE
+                                 : (i % 5 == 1) ? VehicleType::TRUCK : VehicleType::SEDAN;
+                system.createRequest(vehicleID, (i + t) % 4 + 1, type);
+                if (system.allocateSlotForRequest(vehicleID)) allocatedPerThread[t]++;
+            }
+        });
+    }
+    for (thread& gate : gates) gate.join();
+
+    int allocated = 0;
+    for (int count : allocatedPerThread) allocated += count;
+    set<ParkingSlot*> claimedSlots;
+    for (int t = 0; t < threadCount; t++) {
+        for (int i = 0; i < vehiclesPerThread; i++) {
+            ParkingSlot* slot = allocatedSlotOf(system, "G" + to_string(t) + "-" + to_string(i));
+            if (slot != nullptr) claimedSlots.insert(slot);
+        }
+    }
+    AllocationEngine* engine = system.getEngine();
+    coreAssert("Every successful claim got its own slot", (int)claimedSlots.size() == allocated);
+    coreAssert("Claims never exceed capacity", allocated <= engine->getTotalCapacity());
+    coreAssert("Counters match recount after racing claims", countersMatchRecount(system));
+    coreAssert("Free + claimed slots add up to capacity",
+               engine->getTotalAvailableSlots() + allocated == engine->getTotalCapacity());
+
+    // Half the gates drive their vehicles out while the other half keep arriving
+    gates.clear();
+    for (int t = 0; t < threadCount; t++) {
+        gates.emplace_back([&system, t, vehiclesPerThread]() {
+            for (int i = 0; i < vehiclesPerThread; i++) {
+                string vehicleID = "G" + to_string(t) + "-" + to_string(i);
+                if (t % 2 == 0) {
+                    if (system.occupyRequest(vehicleID)) system.releaseRequest(vehicleID);
+                } else {
+                    string lateID = "L" + to_string(t) + "-" + to_string(i);
+                    system.createRequest(lateID, i % 4 + 1);
+                    system.allocateSlotForRequest(lateID);
+                }
+            }
+        });
+    }
+    for (thread& gate : gates) gate.join();
+    coreAssert("Counters match recount after mixed release/claim", countersMatchRecount(system));
+
+    // Load index refreshes deferred by losing writers must all have landed
+    int mostFree = 0;
+    for (Zone* zone : engine->getAllZones()) {
+        if (zone->getAvailableSlots() > mostFree) mostFree = zone->getAvailableSlots();
+    }
+    Zone* leastLoaded = engine->getMostAvailableZone();
+    coreAssert("Load index points at a zone with the most free slots",
+               mostFree == 0 ? leastLoaded == nullptr
+                             : leastLoaded != nullptr && leastLoaded->getAvailableSlots() == mostFree);
+}
+
+// CORE TEST 2: Batch rollback as one group
+void test_batch_group_rollback() {
+    printCoreHeader("Batch Group Rollback");
+
+    ParkingSystem system;
+    system.setVerbose(false);
+    system.createZone(1, 2, 4, 1);
+    system.createZone(2, 1, 3, 1);
+    system.connectZones(1, 2);
+
+    // Pre-existing traffic that must survive the rollback untouched
+    system.createRequest("KEEP-1", 1);
+    system.allocateSlotForRequest("KEEP-1");
+    system.createRequest("KEEP-2", 2, VehicleType::TRUCK);
+    system.allocateSlotForRequest("KEEP-2");
+    system.createRequest("KEEP-3", 1);   // Stays REQUESTED
+    ParkingSlot* keepSlot1 = allocatedSlotOf(system, "KEEP-1");
+    ParkingSlot* keepSlot2 = allocatedSlotOf(system, "KEEP-2");
+
+    int zone1Before = system.getZoneByID(1)->getAvailableSlots();
+    int zone2Before = system.getZoneByID(2)->getAvailableSlots();
+    int activeBefore = system.getActiveRequests().getSize();
+
+    vector<BatchArrival> arrivals;
+    for (int i = 0; i < 10; i++) {
+        arrivals.push_back(BatchArrival("B" + to_string(i), (i % 2) + 1,
+                                        (i % 3 == 0) ? VehicleType::MOTORCYCLE : VehicleType::SEDAN));
+    }
+    arrivals.push_back(BatchArrival("B0", 2));       // Repeat within the batch: skipped
+    arrivals.push_back(BatchArrival("KEEP-1", 2));   // Already active: skipped
+    vector<BatchAllocationResult> results = system.allocateBatch(arrivals);
+
+    vector<ParkingSlot*> batchSlots;
+    for (const BatchAllocationResult& result : results) {
+        ParkingSlot* slot = allocatedSlotOf(system, result.vehicleID);
+        if (result.allocated && slot != nullptr && slot != keepSlot1) batchSlots.push_back(slot);
+    }
+    coreAssert("Batch returns one result per arrival", results.size() == arrivals.size());
+    coreAssert("Repeated and already-active vehicles are not allocated",
+               !results[10].allocated && !results[11].allocated);
+    coreAssert("Batch allocated every free slot", (int)batchSlots.size() == zone1Before + zone2Before);
+
+    coreAssert("rollbackOperations(1) undoes the batch", system.rollbackOperations(1));
+
+    bool slotsFreed = true;
+    for (ParkingSlot* slot : batchSlots) {
+        if (!slot->getIsAvailable()) slotsFreed = false;
+    }
+    bool batchUnindexed = true;
+    for (int i = 0; i < 10; i++) {
+        if (system.getRequestByVehicleID("B" + to_string(i)) != nullptr) batchUnindexed = false;
+    }
+    coreAssert("Every batch slot is free again", slotsFreed);
+    coreAssert("No batch vehicle is left in the vehicle index", batchUnindexed);
+    coreAssert("Zone counters restored",
+               system.getZoneByID(1)->getAvailableSlots() == zone1Before &&
+               system.getZoneByID(2)->getAvailableSlots() == zone2Before);
+    coreAssert("Active request count restored", system.getActiveRequests().getSize() == activeBefore);
+    coreAssert("Earlier requests keep their slots",
+               allocatedSlotOf(system, "KEEP-1") == keepSlot1 && !keepSlot1->getIsAvailable() &&
+               allocatedSlotOf(system, "KEEP-2") == keepSlot2 && !keepSlot2->getIsAvailable());
+    ParkingRequest* waiting = system.getRequestByVehicleID("KEEP-3");
+    coreAssert("Earlier REQUESTED request still indexed",
+               waiting != nullptr && waiting->getCurrentStatus() == RequestState::REQUESTED);
+    coreAssert("Counters match recount after rollback", countersMatchRecount(system));
+
+    // A batch larger than the history can no longer be undone as a unit
+    ParkingSystem shallow(4);
+    shallow.setVerbose(false);
+    shallow.createZone(1, 10);
+    vector<BatchArrival> burst;
+    for (int i = 0; i < 6; i++) burst.push_back(BatchArrival("S" + to_string(i), 1));
+    shallow.allocateBatch(burst);
+    coreAssert("Truncated batch refuses a partial rollback", !shallow.rollbackOperations(1));
+    coreAssert("Truncated batch left allocated", shallow.getZoneByID(1)->getAvailableSlots() == 4);
+}
+
+// CORE TEST 3: Reservation windows
+void test_reservation_windows() {
+    printCoreHeader("Reservation Windows (one slot)");
+
+    ParkingSystem system;
+    system.setVerbose(false);
+    system.createZone(1, 1);
+
+    time_t base = time(nullptr) + 24 * 3600;   // Far enough ahead that nothing activates
+    int first = system.reserveSlot("R1", 1, base + 100, base + 200);
+    coreAssert("First window accepted", first != -1);
+    coreAssert("Window overlapping the end rejected", system.reserveSlot("R2", 1, base + 150, base + 250) == -1);
+    coreAssert("Window overlapping the start rejected", system.reserveSlot("R3", 1, base + 50, base + 101) == -1);
+    coreAssert("Enclosing window rejected", system.reserveSlot("R4", 1, base, base + 300) == -1);
+    coreAssert("Enclosed window rejected", system.reserveSlot("R5", 1, base + 120, base + 180) == -1);
+    coreAssert("Window ending at the start accepted", system.reserveSlot("R6", 1, base, base + 100) != -1);
+    coreAssert("Window starting at the end accepted", system.reserveSlot("R7", 1, base + 200, base + 300) != -1);
+    coreAssert("Empty window rejected", system.reserveSlot("R8", 1, base + 400, base + 400) == -1);
+
+    coreAssert("Cancelling frees the window", system.cancelReservation(1, first));
+    coreAssert("Freed window can be booked again", system.reserveSlot("R9", 1, base + 150, base + 190) != -1);
+    coreAssert("Reservations never take the slot early", system.getZoneByID(1)->getAvailableSlots() == 1);
+}
+
+// CORE TEST 4: Rollback onto a slot that was taken
+void test_rollback_onto_taken_slot() {
+    printCoreHeader("Rollback of a Release Whose Slot Was Taken");
+
+    ParkingSystem system;
+    system.setVerbose(false);
+    system.createZone(1, 1);
+
+    ParkingRequest* parked = system.createRequest("A", 1);
+    system.allocateSlotForRequest("A");
+    system.occupyRequest("A");
+    system.releaseRequest("A");
+    int historyBefore = system.getRollbackManager()->getHistorySize();
+
+    // A reservation whose window has started holds the freed slot
+    time_t now = time(nullptr);
+    int reservationID = system.reserveSlot("R", 1, now - 60, now + 3600);
+    system.activateReservations(now);
+    coreAssert("Reservation holds the only slot", system.getZoneByID(1)->getAvailableSlots() == 0);
+
+    coreAssert("Rolling back the release is refused", !system.rollbackOperations(1));
+    coreAssert("Request stays RELEASED", parked->getCurrentStatus() == RequestState::RELEASED);
+    coreAssert("Vehicle not re-linked", system.getRequestByVehicleID("A") == nullptr);
+    coreAssert("Nothing popped from the history", system.getRollbackManager()->getHistorySize() == historyBefore);
+    coreAssert("Counters match recount", countersMatchRecount(system));
+
+    // Once the hold is gone the same rollback goes through
+    system.cancelReservation(1, reservationID);
+    coreAssert("Rollback succeeds once the slot is free", system.rollbackOperations(1));
+    coreAssert("Request back to OCCUPIED on its slot",
+               parked->getCurrentStatus() == RequestState::OCCUPIED && allocatedSlotOf(system, "A") != nullptr &&
+               !allocatedSlotOf(system, "A")->getIsAvailable());
+    coreAssert("Zone shows the slot taken once", system.getZoneByID(1)->getAvailableSlots() == 0 &&
+               countersMatchRecount(system));
+
+    // A taker inside the rolled-back range gives the slot back first
+    ParkingSystem chained;
+    chained.setVerbose(false);
+    chained.createZone(1, 1);
+    ParkingRequest* first = chained.createRequest("A", 1);
+    chained.allocateSlotForRequest("A");
+    chained.occupyRequest("A");
+    chained.releaseRequest("A");
+    chained.createRequest("B", 1);
+    chained.allocateSlotForRequest("B");
+    coreAssert("Undoing the taker and the release together succeeds", chained.rollbackOperations(3));
+    coreAssert("First vehicle owns the slot again", first->getCurrentStatus() == RequestState::OCCUPIED &&
+               chained.getRequestByVehicleID("B") == nullptr &&
+               chained.getZoneByID(1)->getAvailableSlots() == 0 && countersMatchRecount(chained));
+}
+
+// CORE TEST 5: Size-class best fit
+void test_size_class_best_fit() {
+    printCoreHeader("Size-Class Best Fit");
+
+    ParkingSystem system;
+    system.setVerbose(false);
+    system.createZone(1, 1, 1, 1);   // One COMPACT, one STANDARD, one LARGE
+
+    system.createRequest("M1", 1, VehicleType::MOTORCYCLE);
+    system.allocateSlotForRequest("M1");
+    ParkingSlot* slot = allocatedSlotOf(system, "M1");
+    coreAssert("Motorcycle takes the compact slot", slot != nullptr && slot->getSize() == SlotSize::COMPACT);
+
+    system.createRequest("M2", 1, VehicleType::MOTORCYCLE);
+    system.allocateSlotForRequest("M2");
+    slot = allocatedSlotOf(system, "M2");
+    coreAssert("Next motorcycle moves up one size", slot != nullptr && slot->getSize() == SlotSize::STANDARD);
+
+    system.createRequest("C1", 1, VehicleType::SEDAN);
+    system.allocateSlotForRequest("C1");
+    slot = allocatedSlotOf(system, "C1");
+    coreAssert("Sedan falls back to the large slot", slot != nullptr && slot->getSize() == SlotSize::LARGE);
+
+    system.createRequest("T1", 1, VehicleType::TRUCK);
+    coreAssert("Truck never takes a smaller slot", !system.allocateSlotForRequest("T1"));
+
+    ParkingSystem fresh;
+    fresh.setVerbose(false);
+    fresh.createZone(1, 1, 1, 1);
+    fresh.createRequest("T2", 1, VehicleType::TRUCK);
+    fresh.allocateSlotForRequest("T2");
+    slot = allocatedSlotOf(fresh, "T2");
+    coreAssert("Truck takes the large slot", slot != nullptr && slot->getSize() == SlotSize::LARGE);
+    fresh.createRequest("C2", 1, VehicleType::SEDAN);
+    fresh.allocateSlotForRequest("C2");
+    slot = allocatedSlotOf(fresh, "C2");
+    coreAssert("Sedan skips the smaller compact slot", slot != nullptr && slot->getSize() == SlotSize::STANDARD);
+    coreAssert("Counters match recount", countersMatchRecount(system) && countersMatchRecount(fresh));
+}
+
+// CORE TEST 6: Per-zone free-slot stack
+void test_free_slot_stack() {
+    printCoreHeader("Free-Slot Stack (claims pop, releases push)");
+
+    ParkingSystem system;
+    system.setVerbose(false);
+    system.createZone(1, 0, 64, 0);
+    Zone* zone = system.getZoneByID(1);
+    ParkingArea* area = zone->getAreaAt(0);
+
+    vector<ParkingSlot*> claimed;
+    for (ParkingSlot* slot = zone->claimAvailableSlot(SlotSize::STANDARD); slot != nullptr;
+         slot = zone->claimAvailableSlot(SlotSize::STANDARD)) {
+        claimed.push_back(slot);
+    }
+    set<ParkingSlot*> distinct(claimed.begin(), claimed.end());
+    coreAssert("Every slot claimed exactly once", claimed.size() == 64 && distinct.size() == 64);
+    coreAssert("A fresh zone hands out its lowest slot first", claimed[0] == area->getSlotAt(0));
+
+    area->getSlotAt(30)->free();
+    area->getSlotAt(50)->free();
+    coreAssert("Latest release is claimed first", zone->claimAvailableSlot(SlotSize::STANDARD) == area->getSlotAt(50));
+    coreAssert("Then the one before it", zone->claimAvailableSlot(SlotSize::STANDARD) == area->getSlotAt(30));
+
+    area->getSlotAt(10)->free();
+    area->getSlotAt(20)->free();
+    coreAssert("Slot held directly while still on the stack", area->getSlotAt(20)->allocate());
+    coreAssert("Claim skips the held slot", zone->claimAvailableSlot(SlotSize::STANDARD) == area->getSlotAt(10));
+    coreAssert("Nothing left once the stale entry is dropped", zone->claimAvailableSlot(SlotSize::STANDARD) == nullptr);
+    area->getSlotAt(20)->free();
+    coreAssert("Held slot claimable again after release", zone->claimAvailableSlot(SlotSize::STANDARD) == area->getSlotAt(20));
+
+    for (ParkingSlot* slot : claimed) slot->free();
+    const int THREADS = 4;
+    vector<thread> workers;
+    for (int t = 0; t < THREADS; t++) {
+        workers.emplace_back([zone]() {
+            for (int i = 0; i < 2000; i++) {
+                ParkingSlot* slot = zone->claimAvailableSlot(SlotSize::STANDARD);
+                if (slot != nullptr) slot->free();
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    claimed.clear();
+    for (ParkingSlot* slot = zone->claimAvailableSlot(SlotSize::STANDARD); slot != nullptr;
+         slot = zone->claimAvailableSlot(SlotSize::STANDARD)) {
+        claimed.push_back(slot);
+    }
+    distinct = set<ParkingSlot*>(claimed.begin(), claimed.end());
+    coreAssert("Stack intact after concurrent claim/release", claimed.size() == 64 && distinct.size() == 64);
+    for (ParkingSlot* slot : claimed) slot->free();
+    coreAssert("Counters match recount", countersMatchRecount(system));
+}
+
+// CORE TEST 7: Overflow penalty per adjacency hop
+void test_overflow_penalty_per_hop() {
+    printCoreHeader("Overflow Penalty Per Hop (1 - 2 - 3, 4 unconnected)");
+
+    ParkingSystem system;
+    system.setVerbose(false);
+    for (int z = 1; z <= 4; z++) {
+        system.createZone(z, 1);
+    }
+    system.connectZones(1, 2);
+    system.connectZones(2, 3);
+
+    double expected[] = { 0.0,
+                          PenaltyCosts::CROSS_ZONE_PENALTY_PER_HOP,
+                          2 * PenaltyCosts::CROSS_ZONE_PENALTY_PER_HOP,
+                          PenaltyCosts::UNCONNECTED_ZONE_PENALTY };
+    for (int i = 0; i < 4; i++) {
+        string vehicleID = "P" + to_string(i + 1);
+        system.createRequest(vehicleID, 1);
+        system.allocateSlotForRequest(vehicleID);
+        ParkingSlot* slot = allocatedSlotOf(system, vehicleID);
+        ParkingRequest* request = system.getRequestByVehicleID(vehicleID);
+        coreAssert(vehicleID + " lands in zone " + to_string(i + 1) + " with penalty " + to_string((int)expected[i]),
+                   slot != nullptr && slot->getZoneID() == i + 1 && request->getPenaltyCost() == expected[i]);
+    }
+
+    // Batch results report the same per-hop charge
+    ParkingSystem batchSystem;
+    batchSystem.setVerbose(false);
+    for (int z = 1; z <= 3; z++) {
+        batchSystem.createZone(z, 1);
+    }
+    batchSystem.connectZones(1, 2);
+    batchSystem.connectZones(2, 3);
+    vector<BatchArrival> arrivals;
+    for (int i = 0; i < 3; i++) arrivals.push_back(BatchArrival("Q" + to_string(i + 1), 1));
+    vector<BatchAllocationResult> results = batchSystem.allocateBatch(arrivals);
+    bool batchPenalties = results.size() == 3;
+    for (int i = 0; batchPenalties && i < 3; i++) {
+        batchPenalties = results[i].allocated && results[i].zoneID == i + 1 && results[i].penaltyCost == expected[i];
+    }
+    coreAssert("Batch charges the penalty of each hop", batchPenalties);
+}
+
+bool sameDashboard(const DashboardStats& a, const DashboardStats& b) {
+    if (a.totalRequests != b.totalRequests || a.requestsAllocated != b.requestsAllocated ||
+        a.requestsOccupied != b.requestsOccupied || a.requestsReleased != b.requestsReleased ||
+        a.requestsCancelled != b.requestsCancelled || a.actualOccupiedSlots != b.actualOccupiedSlots ||
+        a.averageParkingDuration != b.averageParkingDuration || a.totalZones != b.totalZones ||
+        a.systemUtilization != b.systemUtilization || a.mostAvailableZoneID != b.mostAvailableZoneID ||
+        a.mostAvailableZoneSlots != b.mostAvailableZoneSlots ||
+        a.zoneStatuses.getSize() != b.zoneStatuses.getSize()) {
+        return false;
+    }
+    auto other = b.zoneStatuses.begin();
+    for (const ZoneSlotStatus& status : a.zoneStatuses) {
+        if (status.zoneID != other->zoneID || status.availableSlots != other->availableSlots ||
+            status.totalSlots != other->totalSlots) {
+            return false;
+        }
+        ++other;
+    }
+    return true;
+}
+
+// CORE TEST 8: Parallel dashboard aggregation
+void test_parallel_dashboard() {
+    printCoreHeader("Parallel Dashboard (work-stealing pool vs serial)");
+
+    ParkingSystem system;
+    system.setVerbose(false);
+    for (int z = 1; z <= 150; z++) {
+        system.createZone(z, 1, 2, 1);
+    }
+    for (int i = 0; i < 500; i++) {
+        string vehicleID = "D" + to_string(i);
+        system.createRequest(vehicleID, i % 150 + 1, (i % 4 == 0) ? VehicleType::VAN : VehicleType::SEDAN);
+        if (!system.allocateSlotForRequest(vehicleID)) continue;
+        if (i % 3 == 0) system.cancelRequest(vehicleID);
+        else if (i % 3 == 1 && system.occupyRequest(vehicleID) && i % 2 == 0) system.releaseRequest(vehicleID);
+    }
+
+    DashboardStats serial = system.getDashboardStats();
+    system.setAnalyticsThreads(3);
+    DashboardStats parallel = system.getDashboardStats();
+    DashboardStats again = system.getDashboardStats();
+    coreAssert("Parallel aggregation matches the serial scan", sameDashboard(serial, parallel));
+    coreAssert("Repeated parallel runs agree", sameDashboard(parallel, again));
+    coreAssert("Every zone reported", serial.zoneStatuses.getSize() == 150 && serial.totalZones == 150);
+    coreAssert("Occupied slots match the engine",
+               serial.actualOccupiedSlots ==
+               system.getEngine()->getTotalCapacity() - system.getEngine()->getTotalAvailableSlots());
+}
+
+// CORE TEST 9: Dashboard publication
+void test_dashboard_publication() {
+    printCoreHeader("Dashboard Publication (batch boundaries and explicit flush)");
+
+    ParkingSystem system;
+    system.setVerbose(false);
+    coreAssert("Nothing published before the first publish", !system.getPublishedDashboard().isValid());
+
+    system.createZone(1, 4);
+    uint64_t first = system.publishIfChanged();
+    DashboardSnapshot before = system.getPublishedDashboard();
+    coreAssert("Flush after a change publishes", first != 0 && before.isValid() && before->totalZones == 1);
+    coreAssert("Flush without a change publishes nothing", system.publishIfChanged() == 0);
+
+    system.createRequest("V1", 1);
+    system.allocateSlotForRequest("V1");
+    coreAssert("Single operations do not publish", system.getPublishedDashboard().getVersion() == first);
+    system.getDashboardStats();
+    system.getRequestByVehicleID("V1");
+    system.cancelRequest("NOBODY");
+    coreAssert("Reads and failed calls leave nothing to publish",
+               system.publishIfChanged() != 0 && system.publishIfChanged() == 0);
+
+    DashboardSnapshot after = system.getPublishedDashboard();
+    coreAssert("Latest version shows the allocation", after->requestsAllocated == 1 && after->actualOccupiedSlots == 1);
+    coreAssert("Older handle keeps its own state", before->totalRequests == 0 && before->actualOccupiedSlots == 0);
+
+    system.setPublishAfterBatch(true);
+    vector<BatchArrival> arrivals;
+    arrivals.push_back(BatchArrival("V2", 1));
+    arrivals.push_back(BatchArrival("V3", 1));
+    system.allocateBatch(arrivals);
+    DashboardSnapshot batched = system.getPublishedDashboard();
+    coreAssert("Batch publishes once on return",
+               batched.getVersion() == after.getVersion() + 1 && batched->requestsAllocated == 3);
+
+    system.rollbackOperations(1);
+    coreAssert("Rollback marks the dashboard changed", system.publishIfChanged() != 0 &&
+               system.getPublishedDashboard()->requestsAllocated == 1);
+}
+
+// CORE TEST 10: Command pipeline
+void test_command_pipeline() {
+    printCoreHeader("Command Pipeline (4 producers, one engine thread)");
+
+    ParkingSystem system;
+    system.setVerbose(false);
+    system.createZone(1, 30);
+    system.createZone(2, 30);
+
+    CommandPipeline pipeline(&system, 16);
+    pipeline.setPublishAfterBatch(true);
+    pipeline.start();
+
+    const int producerCount = 4;
+    const int vehiclesPerProducer = 20;
+    vector<int> allocatedPerProducer(producerCount, 0);
+    vector<thread> producers;
+    for (int p = 0; p < producerCount; p++) {
+        producers.emplace_back([&pipeline, &allocatedPerProducer, p, vehiclesPerProducer]() {
+            vector<future<bool>> allocations;
+            for (int i = 0; i < vehiclesPerProducer; i++) {
+                string vehicleID = "P" + to_string(p) + "-" + to_string(i);
+                pipeline.submit(PipelineCommandType::CREATE, vehicleID, i % 2 + 1);
+                allocations.push_back(pipeline.submit(PipelineCommandType::ALLOCATE, vehicleID));
+            }
+            for (future<bool>& allocation : allocations) {
+                if (allocation.get()) allocatedPerProducer[p]++;
+            }
+        });
+    }
+    for (thread& producer : producers) producer.join();
+    pipeline.stop();
+
+    int allocated = 0;
+    for (int count : allocatedPerProducer) allocated += count;
+    coreAssert("Every command applied", pipeline.getCommandsApplied() == 2 * producerCount * vehiclesPerProducer);
+    coreAssert("Allocations stop exactly at capacity", allocated == 60);
+    coreAssert("Facility filled exactly", system.getEngine()->getTotalAvailableSlots() == 0);
+    DashboardSnapshot published = system.getPublishedDashboard();
+    coreAssert("Last batch published", published.isValid() && published->requestsAllocated == 60);
+    coreAssert("Counters match recount", countersMatchRecount(system));
+}
+
+int main() {
+    cout << "\n" << string(75, '=') << endl;
+    cout << "  PARKING SYSTEM - CORE BEHAVIOUR TESTS" << endl;
+    cout << string(75, '=') << endl;
+
+    test_concurrent_claims();
+    test_batch_group_rollback();
+    test_reservation_windows();
+    test_rollback_onto_taken_slot();
+    test_size_class_best_fit();
+    test_free_slot_stack();
+    test_overflow_penalty_per_hop();
+    test_parallel_dashboard();
+    test_dashboard_publication();
+    test_command_pipeline();
+
+    // Print summary
+    cout << "\n" << string(75, '-') << endl;
+    cout << "  CORE TEST RESULTS SUMMARY" << endl;
+    cout << string(75, '-') << endl;
+    cout << "  Total Tests Passed: " << coreTestsPassed << endl;
+    cout << "  Total Tests Failed: " << coreTestsFailed << endl;
+    cout << "  Total Tests Run:    " << (coreTestsPassed + coreTestsFailed) << endl;
+
+    if (coreTestsFailed == 0) {
+        cout << "\n  ✓ ALL CORE TESTS PASSED!" << endl;
+    } else {
+        cout << "\n  ✗ SOME CORE TESTS FAILED!" << endl;
+    }
+
+    cout << "\n" << string(75, '-') << "\n" << endl;
+
+    return (coreTestsFailed == 0) ? 0 : 1;
+}